@@ -10,6 +10,7 @@
 #include "linglong/builder/linglong_builder.h"
 #include "linglong/cli/cli.h"
 #include "linglong/package/architecture.h"
+#include "linglong/package/erofs_profile.h"
 #include "linglong/package/version.h"
 #include "linglong/repo/client_factory.h"
 #include "linglong/repo/config.h"
@@ -321,13 +322,14 @@ int handleExport(linglong::builder::Builder &builder, const ExportCommandOptions
 {
     // Create a mutable copy of the export options to potentially modify defaults
     auto exportOpts = options.exportSpecificOptions;
-    // layer 默认使用lz4, 保持和之前版本的兼容
-    if (exportOpts.compressor.empty()) {
-        qInfo() << "Compressor not specified, defaulting to lz4 for layer export.";
-        exportOpts.compressor = "lz4";
-    }
 
     if (options.layerMode) {
+        // layer 默认使用lz4, 保持和之前版本的兼容
+        if (exportOpts.compressor.empty()) {
+            qInfo() << "Compressor not specified, defaulting to lz4 for layer export.";
+            exportOpts.compressor = "lz4";
+        }
+
         auto result = builder.exportLayer(exportOpts);
         if (!result) {
             qCritical() << "Export layer failed: " << result.error();
@@ -828,6 +830,19 @@ You can report bugs to the linyaps team under this project: https://github.com/O
     buildBuilder->add_flag("--isolate-network",
                            buildOpts.builderSpecificOptions.isolateNetWork,
                            _("Build in an isolated network environment"));
+    buildBuilder
+      ->add_option("--compiler-cache",
+                   buildOpts.builderSpecificOptions.compilerCache,
+                   _("Cache compiler output across builds with ccache or sccache"))
+      ->type_name("TOOL")
+      ->check(CLI::IsMember({ "ccache", "sccache" }));
+    buildBuilder->add_flag("--shared-compiler-cache",
+                           buildOpts.builderSpecificOptions.sharedCompilerCache,
+                           _("Share the compiler cache with projects using the same base and "
+                             "runtime"));
+    buildBuilder->add_flag("--incremental",
+                           buildOpts.builderSpecificOptions.incremental,
+                           _("Keep the build output of last build and only install changed files"));
 
     // add builder run
     auto buildRun = commandParser.add_subcommand("run", _("Run built linyaps app"));
@@ -884,6 +899,14 @@ You can report bugs to the linyaps team under this project: https://github.com/O
       ->type_name("FILE")
       ->check(CLI::ExistingFile)
       ->excludes(layerFlag);
+    buildExport
+      ->add_option("--erofs-profile",
+                   exportOpts.exportSpecificOptions.erofsProfile,
+                   _("Erofs profile of the uab: default, fast-build (for CI), small (for "
+                     "release), fast-read (for apps reading large assets randomly)"))
+      ->type_name("PROFILE")
+      ->check(CLI::IsMember(linglong::package::erofsProfileNames()))
+      ->excludes(layerFlag);
     buildExport
       ->add_flag("--no-develop",
                  exportOpts.exportSpecificOptions.noExportDevelop,
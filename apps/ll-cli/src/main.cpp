@@ -8,16 +8,19 @@
 #include "linglong/cli/cli.h"
 #include "linglong/cli/cli_printer.h"
 #include "linglong/cli/dbus_notifier.h"
-#include "linglong/cli/dummy_notifier.h"
 #include "linglong/cli/json_printer.h"
+#include "linglong/cli/lazy_notifier.h"
 #include "linglong/cli/terminal_notifier.h"
 #include "linglong/repo/config.h"
 #include "linglong/repo/ostree_repo.h"
 #include "linglong/runtime/container_builder.h"
+#include "linglong/utils/file.h"
 #include "linglong/utils/finally/finally.h"
 #include "linglong/utils/gettext.h"
 #include "linglong/utils/global/initialize.h"
 #include "linglong/utils/log/log.h"
+#include "linglong/utils/readiness.h"
+#include "linglong/utils/trace/span.h"
 #include "ocppi/cli/crun/Crun.hpp"
 
 #include <CLI/CLI.hpp>
@@ -29,6 +32,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <filesystem>
 #include <functional>
 #include <memory>
 #include <thread>
@@ -43,11 +47,14 @@ using namespace linglong::cli;
 
 namespace {
 
-void startProcess(const QString &program, const QStringList &args = {})
+void startProcess(const QString &program,
+                  const QStringList &args = {},
+                  const QStringList &extraEnvs = {})
 {
     QProcess process;
     auto envs = process.environment();
     envs.push_back("QT_FORCE_STDERR_LOGGING=1");
+    envs.append(extraEnvs);
     process.setEnvironment(envs);
     process.setProgram(program);
     process.setArguments(args);
@@ -380,6 +387,9 @@ ll-cli search . --type=runtime)"));
     cliSearch->add_flag("--show-all-version",
                         searchOptions.showAllVersion,
                         _("Show all versions of an application(s), base(s) or runtime(s)"));
+    cliSearch->add_flag("--refresh",
+                        searchOptions.refresh,
+                        _("Ignore cached search results and query the remote repositories"));
 }
 
 // Function to add the list subcommand
@@ -596,10 +606,79 @@ void addDirCommand(CLI::App &commandParser, DirOptions &dirOptions, const std::s
 
 using namespace linglong::utils::global;
 
+bool isRepositoryReady() noexcept
+{
+    std::error_code ec;
+    if (!std::filesystem::exists(LINGLONG_ROOT "/repo/config", ec)) {
+        return false;
+    }
+
+    auto version = linglong::utils::readFile(LINGLONG_ROOT "/.version");
+    return version && *version == LINGLONG_VERSION;
+}
+
+linglong::utils::error::Result<linglong::api::dbus::v1::PackageManager *>
+connectPackageManager(bool noDBus) noexcept
+{
+    LINGLONG_TRACE("connect to package manager");
+
+    if (noDBus) {
+        // package manager notifies us as soon as it is listening on the socket
+        auto listener = linglong::utils::ReadinessListener::create();
+        if (!listener) {
+            return LINGLONG_ERR(listener);
+        }
+
+        const auto pkgManAddress = QString("unix:path=/tmp/linglong-package-manager.socket");
+        startProcess("sudo",
+                     { "--user",
+                       LINGLONG_USERNAME,
+                       "--preserve-env=QT_FORCE_STDERR_LOGGING",
+                       "--preserve-env=QDBUS_DEBUG",
+                       "--preserve-env=NOTIFY_SOCKET",
+                       LINGLONG_LIBEXEC_DIR "/ll-package-manager",
+                       "--no-dbus" },
+                     { "NOTIFY_SOCKET=" + QString::fromStdString(listener->address()) });
+
+        using namespace std::chrono_literals;
+        if (auto ret = listener->wait(30s); !ret) {
+            return LINGLONG_ERR("ll-package-manager is not ready", ret);
+        }
+
+        auto pkgManConn = QDBusConnection::connectToPeer(pkgManAddress, "ll-package-manager");
+        if (!pkgManConn.isConnected()) {
+            return LINGLONG_ERR("failed to connect to ll-package-manager: "
+                                + pkgManConn.lastError().message());
+        }
+
+        return new linglong::api::dbus::v1::PackageManager("",
+                                                           "/org/deepin/linglong/PackageManager1",
+                                                           pkgManConn,
+                                                           QCoreApplication::instance());
+    }
+
+    auto pkgManConn = QDBusConnection::systemBus();
+    // ping package manager to make it initialize system linglong repository
+    auto peer = linglong::api::dbus::v1::DBusPeer("org.deepin.linglong.PackageManager1",
+                                                  "/org/deepin/linglong/PackageManager1",
+                                                  pkgManConn);
+    auto reply = peer.Ping();
+    reply.waitForFinished();
+    if (!reply.isValid()) {
+        return LINGLONG_ERR("failed to activate org.deepin.linglong.PackageManager1: "
+                            + reply.error().message());
+    }
+
+    return new linglong::api::dbus::v1::PackageManager("org.deepin.linglong.PackageManager1",
+                                                       "/org/deepin/linglong/PackageManager1",
+                                                       pkgManConn,
+                                                       QCoreApplication::instance());
+}
+
 // 初始化仓库
 linglong::utils::error::Result<linglong::repo::OSTreeRepo *> initOSTreeRepo()
 {
-    LINGLONG_TRACE("initOSTreeRepo");
+    LINGLONG_TRACE_SPAN("initOSTreeRepo");
     // load repo config
     auto repoConfig = linglong::repo::loadConfig(
       { LINGLONG_ROOT "/config.yaml", LINGLONG_DATA_DIR "/config.yaml" });
@@ -740,14 +819,7 @@ You can report bugs to the linyaps team under this project: https://github.com/O
         break;
     }
 
-    // connect to package manager
-    auto pkgManConn = QDBusConnection::systemBus();
-    auto *pkgMan =
-      new linglong::api::dbus::v1::PackageManager("org.deepin.linglong.PackageManager1",
-                                                  "/org/deepin/linglong/PackageManager1",
-                                                  pkgManConn,
-                                                  QCoreApplication::instance());
-    // if --no-dbus flag is set, start package manager in sudo mode
+    // if --no-dbus flag is set, package manager will be started in sudo mode
     if (*noDBusFlag) {
         if (getuid() != 0) {
             qCritical() << "--no-dbus should only be used by root user.";
@@ -755,36 +827,31 @@ You can report bugs to the linyaps team under this project: https://github.com/O
         }
 
         qInfo() << "some subcommands will failed in --no-dbus mode.";
-        const auto pkgManAddress = QString("unix:path=/tmp/linglong-package-manager.socket");
-        startProcess("sudo",
-                     { "--user",
-                       LINGLONG_USERNAME,
-                       "--preserve-env=QT_FORCE_STDERR_LOGGING",
-                       "--preserve-env=QDBUS_DEBUG",
-                       LINGLONG_LIBEXEC_DIR "/ll-package-manager",
-                       "--no-dbus" });
-        QThread::sleep(1);
+    }
 
-        pkgManConn = QDBusConnection::connectToPeer(pkgManAddress, "ll-package-manager");
-        if (!pkgManConn.isConnected()) {
-            qCritical() << "Failed to connect to ll-package-manager:" << pkgManConn.lastError();
-            return -1;
+    // connect to package manager on first use, subcommands which only read local state
+    // don't need it at all
+    PackageManagerFactory pkgManFactory =
+      [noDBus = static_cast<bool>(*noDBusFlag),
+       pkgMan = static_cast<linglong::api::dbus::v1::PackageManager *>(nullptr)]() mutable
+      -> Result<linglong::api::dbus::v1::PackageManager *> {
+        if (pkgMan == nullptr) {
+            auto ret = connectPackageManager(noDBus);
+            if (!ret) {
+                return ret;
+            }
+            pkgMan = *ret;
         }
 
-        pkgMan = new linglong::api::dbus::v1::PackageManager("",
-                                                             "/org/deepin/linglong/PackageManager1",
-                                                             pkgManConn,
-                                                             QCoreApplication::instance());
-    } else {
-        // ping package manager to make it initialize system linglong repository
-        auto peer = linglong::api::dbus::v1::DBusPeer("org.deepin.linglong.PackageManager1",
-                                                      "/org/deepin/linglong/PackageManager1",
-                                                      pkgManConn);
-        auto reply = peer.Ping();
-        reply.waitForFinished();
-        if (!reply.isValid()) {
-            qCritical() << "Failed to activate org.deepin.linglong.PackageManager1"
-                        << reply.error();
+        return pkgMan;
+    };
+
+    // the package manager initializes and migrates the system linglong repository on startup,
+    // so activate it up front only if the repository isn't ready yet
+    if (!isRepositoryReady()) {
+        auto ret = pkgManFactory();
+        if (!ret) {
+            qCritical() << ret.error();
             return -1;
         }
     }
@@ -820,26 +887,23 @@ You can report bugs to the linyaps team under this project: https://github.com/O
     auto *containerBuilder = new linglong::runtime::ContainerBuilder(**ociRuntime);
     containerBuilder->setParent(QCoreApplication::instance());
 
-    // create notifier
-    std::unique_ptr<InteractiveNotifier> notifier{ nullptr };
+    // create notifier, the real one is created on first interaction
+    auto notifier = std::make_unique<LazyNotifier>([]() -> std::unique_ptr<InteractiveNotifier> {
+        // if ll-cli is running in tty, should use terminalNotifier.
+        if (::isatty(STDIN_FILENO) != 0 && ::isatty(STDOUT_FILENO) != 0) {
+            return std::make_unique<TerminalNotifier>();
+        }
 
-    // if ll-cli is running in tty, should use terminalNotifier.
-    if (::isatty(STDIN_FILENO) != 0 && ::isatty(STDOUT_FILENO) != 0) {
-        notifier = std::make_unique<TerminalNotifier>();
-    } else {
         try {
-            notifier = std::make_unique<DBusNotifier>();
+            return std::make_unique<DBusNotifier>();
         } catch (std::runtime_error &err) {
             qInfo() << "initialize DBus notifier failed:" << err.what()
                     << "try to fallback to terminal notifier.";
         }
-    }
 
-    if (!notifier) {
-        qInfo() << "Using DummyNotifier, expected interactions and prompts will not be "
-                   "displayed.";
-        notifier = std::make_unique<linglong::cli::DummyNotifier>();
-    }
+        return nullptr;
+    });
+
     auto repo = initOSTreeRepo();
     if (!repo.has_value()) {
         qCritical() << "initOSTreeRepo failed" << repo.error();
@@ -849,7 +913,7 @@ You can report bugs to the linyaps team under this project: https://github.com/O
     auto *cli = new linglong::cli::Cli(*printer,
                                        **ociRuntime,
                                        *containerBuilder,
-                                       *pkgMan,
+                                       std::move(pkgManFactory),
                                        **repo,
                                        std::move(notifier),
                                        QCoreApplication::instance());
@@ -5,18 +5,25 @@
 #include <sys/epoll.h>
 #include <sys/prctl.h>
 #include <sys/signalfd.h>
+#include <sys/syscall.h>
 #include <sys/timerfd.h>
 
 #include <array>
 #include <csignal>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <ctime>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <optional>
+#include <string>
 #include <vector>
 
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <fcntl.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
@@ -33,6 +40,7 @@ struct WaitPidResult
 {
     pid_t pid;
     int status;
+    bool exited;
 };
 
 void print_sys_error(std::string_view msg) noexcept
@@ -259,8 +267,56 @@ void print_child_status(int status, const std::string &pid) noexcept
     }
 }
 
+// microseconds of CLOCK_MONOTONIC, the same clock used by the spans of ll-cli
+int64_t trace_now() noexcept
+{
+    struct timespec ts{};
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+const int64_t init_start = trace_now();
+
+// ll-cli passes its LINGLONG_TRACE_FILE to the container through /run/host/rootfs, the file has
+// been created by ll-cli, so don't create it here
+void record_exec_span() noexcept
+{
+    const auto *trace_file = ::getenv("LINGLONG_TRACE_FILE");
+    if (trace_file == nullptr || trace_file[0] == '\0') {
+        return;
+    }
+
+    auto fd = file_descriptor_wrapper(::open(trace_file, O_WRONLY | O_APPEND | O_CLOEXEC));
+    if (!fd) {
+        print_sys_error("Failed to open trace file");
+        return;
+    }
+
+    const auto pid = std::to_string(::getpid());
+    const auto end = trace_now();
+    // the events are appended by a single write as ll-cli does
+    auto events = std::string{ ",\n{\"args\":{\"name\":\"ll-init\"},\"name\":\"process_name\"," };
+    events += "\"ph\":\"M\",\"pid\":" + pid;
+    events += "},\n{\"cat\":\"linglong\",\"dur\":" + std::to_string(end - init_start);
+    events += ",\"name\":\"ll-init exec\",\"ph\":\"X\",\"pid\":" + pid + ",\"tid\":" + pid;
+    events += ",\"ts\":" + std::to_string(init_start) + "}";
+    if (::write(fd, events.c_str(), events.size()) != static_cast<ssize_t>(events.size())) {
+        print_sys_error("Failed to write trace file");
+    }
+}
+
 pid_t run(std::vector<const char *> args, const sigConf &conf) noexcept
 {
+    // the write end is closed by execvp, then the time to exec the child could be recorded
+    std::array<int, 2> exec_pipe{ -1, -1 };
+    const auto *trace_file = ::getenv("LINGLONG_TRACE_FILE");
+    if (trace_file != nullptr && trace_file[0] != '\0'
+        && ::pipe2(exec_pipe.data(), O_CLOEXEC) == -1) {
+        print_sys_error("Failed to create pipe");
+    }
+    auto exec_reader = file_descriptor_wrapper(exec_pipe[0]);
+    auto exec_writer = file_descriptor_wrapper(exec_pipe[1]);
+
     auto pid = ::fork();
     if (pid == -1) {
         print_sys_error("Failed to fork");
@@ -268,6 +324,7 @@ pid_t run(std::vector<const char *> args, const sigConf &conf) noexcept
     }
 
     if (pid == 0) {
+        exec_reader.close();
         auto ret = ::setpgid(0, 0);
         if (ret == -1) {
             print_sys_error("Failed to set process group");
@@ -289,12 +346,18 @@ pid_t run(std::vector<const char *> args, const sigConf &conf) noexcept
         ::_exit(EXIT_FAILURE);
     }
 
+    if (exec_reader) {
+        exec_writer.close();
+
+        char buf{};
+        while (::read(exec_reader, &buf, sizeof(buf)) == -1 && errno == EINTR) { }
+        record_exec_span();
+    }
+
     return pid;
 }
 
-bool handle_sigevent(const file_descriptor_wrapper &sigfd,
-                     pid_t child,
-                     struct WaitPidResult &waitChild) noexcept
+bool handle_sigevent(const file_descriptor_wrapper &sigfd, pid_t child) noexcept
 {
     while (true) {
         signalfd_siginfo info{};
@@ -308,46 +371,71 @@ bool handle_sigevent(const file_descriptor_wrapper &sigfd,
             return false;
         }
 
-        if (info.ssi_signo != SIGCHLD) {
-            if (info.ssi_pid != 0) {
-                auto ret = ::kill(child, info.ssi_signo);
-                if (ret == -1) {
-                    auto msg =
-                      std::string("Failed to forward signal ") + ::strsignal(info.ssi_signo);
-                    print_sys_error(msg);
-                }
-            }
-
-            print_info("Received signal " + std::to_string(info.ssi_signo)
-                       + " from kernel, just ignore it");
+        // children are reaped after all the events are handled
+        if (info.ssi_signo == SIGCHLD) {
             continue;
         }
 
-        while (true) {
-            int status{};
-            auto ret = ::waitpid(-1, &status, WNOHANG);
-            if (ret == 0 || (ret == -1 && errno == ECHILD)) {
-                break;
-            }
-
+        if (info.ssi_pid != 0) {
+            auto ret = ::kill(child, info.ssi_signo);
             if (ret == -1) {
-                print_sys_error("Failed to wait for child");
-                return false;
+                auto msg = std::string("Failed to forward signal ") + ::strsignal(info.ssi_signo);
+                print_sys_error(msg);
             }
+        }
 
-            print_child_status(status, std::to_string(ret));
+        print_info("Received signal " + std::to_string(info.ssi_signo)
+                   + " from kernel, just ignore it");
+    }
+
+    return true;
+}
+
+// As the init process of the pid namespace, all the processes started in the container are our
+// descendants and the orphans are reparented to us, so ECHILD means that the last one has exited.
+// Returns -1 on error, 0 if no child is left and 1 if some children are still running.
+int reap_children(WaitPidResult &waitChild) noexcept
+{
+    while (true) {
+        int status{};
+        auto ret = ::waitpid(-1, &status, WNOHANG);
+        if (ret == 0) {
+            return 1;
+        }
 
-            if (ret == child) {
-                waitChild.pid = child;
-                waitChild.status = status;
+        if (ret == -1) {
+            if (errno == ECHILD) {
+                return 0;
             }
+
+            print_sys_error("Failed to wait for child");
+            return -1;
+        }
+
+        print_child_status(status, std::to_string(ret));
+
+        if (ret == waitChild.pid) {
+            waitChild.status = status;
+            waitChild.exited = true;
         }
     }
+}
 
-    return true;
+bool is_zombie(const std::filesystem::path &proc) noexcept
+{
+    std::ifstream stat{ proc / "stat" };
+    std::string content;
+    if (!std::getline(stat, content)) {
+        return false;
+    }
+
+    // the state follows the command which is enclosed in parentheses, e.g. "2 (bash) Z ..."
+    auto pos = content.rfind(')');
+    return pos != std::string::npos && pos + 2 < content.size() && content[pos + 2] == 'Z';
 }
 
-bool shouldWait() noexcept
+// the processes which are not our descendants, e.g. the ones joined the namespace by setns
+std::optional<std::vector<pid_t>> foreign_processes() noexcept
 {
     std::error_code ec;
     auto proc_it = std::filesystem::directory_iterator{
@@ -358,9 +446,10 @@ bool shouldWait() noexcept
 
     if (ec) {
         print_sys_error("Failed to open /proc", ec);
-        return false;
+        return std::nullopt;
     }
 
+    std::vector<pid_t> pids;
     for (const auto &entry : proc_it) {
         if (!entry.is_directory(ec)) {
             continue;
@@ -368,7 +457,7 @@ bool shouldWait() noexcept
 
         if (ec) {
             print_sys_error("Failed to stat " + entry.path().string(), ec);
-            return false;
+            return std::nullopt;
         }
 
         pid_t pid{ -1 };
@@ -378,21 +467,30 @@ bool shouldWait() noexcept
             continue;
         }
 
-        if (pid == 1) { // ignore init process
+        // ignore init process and the exited processes which are waiting for their parents
+        if (pid == 1 || pid == ::getpid() || is_zombie(entry.path())) {
             continue;
         }
 
-        // if we get here, it means some process is still alive
-        return true;
+        pids.emplace_back(pid);
     }
 
-    return false;
+    return pids;
+}
+
+file_descriptor_wrapper open_pidfd(pid_t pid) noexcept
+{
+#ifdef SYS_pidfd_open
+    return file_descriptor_wrapper(static_cast<int>(::syscall(SYS_pidfd_open, pid, 0)));
+#else
+    errno = ENOSYS;
+    return {};
+#endif
 }
 
-int handle_timerfdevent(const file_descriptor_wrapper &timerfd) noexcept
+bool handle_timerfdevent(const file_descriptor_wrapper &timerfd) noexcept
 {
-    // we don't care how many times we read from the timerfd
-    // just traversal the /proc directory once
+    // we don't care how many times the timer expired
     while (true) {
         uint64_t expir{};
         auto ret = ::read(timerfd, &expir, sizeof(expir));
@@ -402,11 +500,11 @@ int handle_timerfdevent(const file_descriptor_wrapper &timerfd) noexcept
             }
 
             print_sys_error("Failed to read from timerfd");
-            return -1;
+            return false;
         }
     }
 
-    return shouldWait() ? 1 : 0;
+    return true;
 }
 
 file_descriptor_wrapper start_timer(const file_descriptor_wrapper &epfd) noexcept
@@ -586,6 +684,52 @@ bool register_event(const file_descriptor_wrapper &epfd,
     return true;
 }
 
+// Processes which are not our descendants don't send SIGCHLD to us, watch them by pidfd or poll
+// /proc by the timer if pidfd isn't supported. Returns -1 on error, 0 if there is nothing to
+// watch and 1 otherwise.
+int watch_foreign_processes(const file_descriptor_wrapper &epfd,
+                            std::vector<file_descriptor_wrapper> &pidfds,
+                            file_descriptor_wrapper &timerfd) noexcept
+{
+    pidfds.clear();
+    while (true) {
+        auto pids = foreign_processes();
+        if (!pids) {
+            return -1;
+        }
+
+        if (pids->empty()) {
+            return 0;
+        }
+
+        for (auto pid : *pids) {
+            auto pidfd = open_pidfd(pid);
+            if (!pidfd) {
+                if (errno == ESRCH) {
+                    continue;
+                }
+
+                print_sys_error("Failed to open pidfd, fallback to polling");
+                pidfds.clear();
+                if (!timerfd) {
+                    timerfd = start_timer(epfd);
+                }
+                return timerfd ? 1 : -1;
+            }
+
+            if (!register_event(epfd, pidfd, { .events = EPOLLIN, .data = { .fd = pidfd } })) {
+                return -1;
+            }
+            pidfds.emplace_back(std::move(pidfd));
+        }
+
+        // all of them have exited before being watched
+        if (!pidfds.empty()) {
+            return 1;
+        }
+    }
+}
+
 } // namespace
 
 int main(int argc, char **argv) // NOLINT
@@ -646,9 +790,9 @@ int main(int argc, char **argv) // NOLINT
     }
 
     file_descriptor_wrapper timerfd;
-    bool done{ false };
+    std::vector<file_descriptor_wrapper> pidfds;
     std::array<struct epoll_event, 10> events{};
-    WaitPidResult waitChild{ .pid = child };
+    WaitPidResult waitChild{ .pid = child, .status = 0, .exited = false };
     int childExitCode = 0;
     while (true) {
         ret = ::epoll_wait(epfd, events.data(), events.size(), -1);
@@ -661,57 +805,69 @@ int main(int argc, char **argv) // NOLINT
             return -1;
         }
 
+        bool check{ false };
         for (auto i = 0; i < ret; ++i) {
             const auto event = events.at(i);
             if (event.data.fd == sigfd) {
-                if (!handle_sigevent(sigfd, waitChild.pid, waitChild)) {
+                if (!handle_sigevent(sigfd, waitChild.pid)) {
                     return -1;
                 }
 
-                if (waitChild.pid == child) {
-                    // Init process will propagate received signals to all child processes (using
-                    // pid -1) after initial child exits
-                    if (WIFEXITED(waitChild.status)) {
-                        waitChild.pid = -1;
-                        childExitCode = WEXITSTATUS(waitChild.status);
-                    } else if (WIFSIGNALED(waitChild.status)) {
-                        waitChild.pid = -1;
-                        childExitCode = 128 + WTERMSIG(waitChild.status);
-                    }
-
-                    if (!shouldWait()) {
-                        done = true;
-                    }
-                    timerfd = start_timer(epfd);
-                    if (!timerfd) {
-                        return -1;
-                    }
-                }
-
+                check = true;
                 continue;
             }
 
-            if (event.data.fd == timerfd) {
-                ret = handle_timerfdevent(timerfd);
-                if (ret == -1) {
+            if (timerfd && event.data.fd == timerfd) {
+                if (!handle_timerfdevent(timerfd)) {
                     return -1;
                 }
 
-                if (ret == 0) {
-                    done = true;
-                }
-
+                check = true;
                 continue;
             }
 
             if (unix_socket && event.data.fd == unix_socket) {
-                if (handle_client(unix_socket, conf)) {
-                    done = false;
-                }
+                handle_client(unix_socket, conf);
+                continue;
+            }
+
+            // one of the watched processes exited, the rest are watched again after checking
+            pidfds.clear();
+            check = true;
+        }
+
+        if (!check) {
+            continue;
+        }
+
+        auto children = reap_children(waitChild);
+        if (children == -1) {
+            return -1;
+        }
+
+        if (waitChild.exited) {
+            // Init process will propagate received signals to all child processes (using
+            // pid -1) after initial child exits
+            if (WIFEXITED(waitChild.status)) {
+                childExitCode = WEXITSTATUS(waitChild.status);
+            } else if (WIFSIGNALED(waitChild.status)) {
+                childExitCode = 128 + WTERMSIG(waitChild.status);
             }
+            waitChild.pid = -1;
+            waitChild.exited = false;
+        }
+
+        // the container exits once the initial child and all the other processes have exited
+        if (waitChild.pid != -1 || children != 0) {
+            continue;
+        }
+
+        auto watching = watch_foreign_processes(epfd, pidfds, timerfd);
+        if (watching == -1) {
+            return -1;
         }
 
-        if (done) {
+        if (watching == 0) {
             unix_socket.close();
             break;
         }
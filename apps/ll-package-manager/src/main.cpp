@@ -12,6 +12,7 @@
 #include "linglong/repo/ostree_repo.h"
 #include "linglong/utils/dbus/register.h"
 #include "linglong/utils/global/initialize.h"
+#include "linglong/utils/readiness.h"
 #include "ocppi/cli/CLI.hpp"
 #include "ocppi/cli/crun/Crun.hpp"
 
@@ -150,6 +151,12 @@ void withoutDBusDaemon(ocppi::cli::CLI &cli)
             unregisterDBusObject(conn, "/org/deepin/linglong/PackageManager1");
         });
     });
+
+    // tell ll-cli that we are ready to accept connections
+    result = linglong::utils::notifyReady();
+    if (!result.has_value()) {
+        qWarning() << result.error().message();
+    }
 }
 
 } // namespace
@@ -1019,13 +1019,29 @@ j["RemoteRef"] = x.remoteRef;
 }
 
 inline void from_json(const json & j, PackageManager1SearchParameters& x) {
+x.excludeModules = get_stack_optional<std::vector<std::string>>(j, "exclude_modules");
 x.id = j.at("id").get<std::string>();
+x.kind = get_stack_optional<std::string>(j, "kind");
+x.latestOnly = get_stack_optional<bool>(j, "latest_only");
+x.refresh = get_stack_optional<bool>(j, "refresh");
 x.repos = j.at("repos").get<std::vector<std::string>>();
 }
 
 inline void to_json(json & j, const PackageManager1SearchParameters & x) {
 j = json::object();
+if (x.excludeModules) {
+j["exclude_modules"] = x.excludeModules;
+}
 j["id"] = x.id;
+if (x.kind) {
+j["kind"] = x.kind;
+}
+if (x.latestOnly) {
+j["latest_only"] = x.latestOnly;
+}
+if (x.refresh) {
+j["refresh"] = x.refresh;
+}
 j["repos"] = x.repos;
 }
 
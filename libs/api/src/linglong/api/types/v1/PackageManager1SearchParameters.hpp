@@ -32,10 +32,26 @@ using nlohmann::json;
 */
 struct PackageManager1SearchParameters {
 /**
+* modules which should be excluded from search result
+*/
+std::optional<std::vector<std::string>> excludeModules;
+/**
 * id of package manager search
 */
 std::string id;
 /**
+* only keep packages of this kind in search result
+*/
+std::optional<std::string> kind;
+/**
+* only keep the latest version of each package module in search result
+*/
+std::optional<bool> latestOnly;
+/**
+* drop cached remote search results and query remote repositories again
+*/
+std::optional<bool> refresh;
+/**
 * repo of package manager search
 */
 std::vector<std::string> repos;
@@ -0,0 +1,165 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "install_snapshot.h"
+
+#include "linglong/utils/log/log.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <system_error>
+
+#include <sys/stat.h>
+
+namespace linglong::builder {
+
+utils::error::Result<InstallSnapshot>
+InstallSnapshot::scan(const std::filesystem::path &root) noexcept
+{
+    LINGLONG_TRACE(fmt::format("scan {}", root).c_str());
+
+    InstallSnapshot snapshot;
+    std::error_code ec;
+    for (auto iter = std::filesystem::recursive_directory_iterator(root, ec);
+         iter != std::filesystem::recursive_directory_iterator();
+         iter.increment(ec)) {
+        if (ec) {
+            break;
+        }
+
+        struct stat st{};
+        if (::lstat(iter->path().c_str(), &st) == -1) {
+            return LINGLONG_ERR(fmt::format("failed to stat {}", iter->path()).c_str(), errno);
+        }
+
+        auto path = "/" + iter->path().lexically_relative(root).string();
+        snapshot.stamps.emplace(std::move(path),
+                                Stamp{
+                                  .mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000
+                                    + st.st_mtim.tv_nsec,
+                                  .inode = st.st_ino,
+                                  .size = st.st_size,
+                                });
+    }
+    if (ec) {
+        return LINGLONG_ERR(fmt::format("failed to iterate {}: {}", root, ec.message()).c_str());
+    }
+
+    return snapshot;
+}
+
+utils::error::Result<InstallSnapshot>
+InstallSnapshot::load(const std::filesystem::path &file) noexcept
+{
+    LINGLONG_TRACE(fmt::format("load install snapshot {}", file).c_str());
+
+    std::ifstream stream(file);
+    if (!stream.is_open()) {
+        return LINGLONG_ERR("failed to open file");
+    }
+
+    auto json = nlohmann::json::parse(stream, nullptr, false);
+    if (json.is_discarded() || !json.is_object()) {
+        return LINGLONG_ERR("invalid install snapshot");
+    }
+
+    InstallSnapshot snapshot;
+    try {
+        snapshot.rulesDigest = json.at("rulesDigest").get<std::string>();
+        for (const auto &[path, stamp] : json.at("stamps").items()) {
+            snapshot.stamps.emplace(path,
+                                    Stamp{
+                                      .mtime = stamp.at(0).get<int64_t>(),
+                                      .inode = stamp.at(1).get<uint64_t>(),
+                                      .size = stamp.at(2).get<int64_t>(),
+                                    });
+        }
+    } catch (const nlohmann::json::exception &e) {
+        return LINGLONG_ERR(fmt::format("invalid install snapshot: {}", e.what()).c_str());
+    }
+
+    return snapshot;
+}
+
+utils::error::Result<void> InstallSnapshot::save(const std::filesystem::path &file) const noexcept
+{
+    LINGLONG_TRACE(fmt::format("save install snapshot {}", file).c_str());
+
+    auto stamps = nlohmann::json::object();
+    for (const auto &[path, stamp] : this->stamps) {
+        stamps[path] = { stamp.mtime, stamp.inode, stamp.size };
+    }
+    nlohmann::json json{
+        { "rulesDigest", this->rulesDigest },
+        { "stamps", std::move(stamps) },
+    };
+
+    // write to a temporary file first, a truncated snapshot must not be used
+    auto tmpFile = file;
+    tmpFile += ".tmp";
+    {
+        std::ofstream stream(tmpFile, std::ios::trunc);
+        if (!stream.is_open()) {
+            return LINGLONG_ERR(fmt::format("failed to open {}", tmpFile).c_str());
+        }
+        stream << json.dump();
+        if (!stream.flush()) {
+            return LINGLONG_ERR(fmt::format("failed to write {}", tmpFile).c_str());
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpFile, file, ec);
+    if (ec) {
+        return LINGLONG_ERR(fmt::format("failed to rename {}: {}", tmpFile, ec.message()).c_str());
+    }
+
+    return LINGLONG_OK;
+}
+
+std::vector<std::string>
+InstallSnapshot::changedSince(const InstallSnapshot &previous) const noexcept
+{
+    std::vector<std::string> changed;
+    for (const auto &[path, stamp] : this->stamps) {
+        auto it = previous.stamps.find(path);
+        if (it == previous.stamps.end() || it->second != stamp) {
+            changed.push_back(path);
+        }
+    }
+
+    return changed;
+}
+
+std::vector<std::string>
+InstallSnapshot::removedSince(const InstallSnapshot &previous) const noexcept
+{
+    std::vector<std::string> removed;
+    for (const auto &[path, stamp] : previous.stamps) {
+        if (this->stamps.find(path) == this->stamps.end()) {
+            removed.push_back(path);
+        }
+    }
+
+    // a parent sorts before its children
+    std::reverse(removed.begin(), removed.end());
+    return removed;
+}
+
+std::vector<std::string> InstallSnapshot::entries() const noexcept
+{
+    std::vector<std::string> entries;
+    entries.reserve(this->stamps.size());
+    for (const auto &[path, stamp] : this->stamps) {
+        entries.push_back(path);
+    }
+
+    return entries;
+}
+
+} // namespace linglong::builder
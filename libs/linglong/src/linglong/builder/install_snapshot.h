@@ -0,0 +1,59 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "linglong/utils/error/error.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace linglong::builder {
+
+// InstallSnapshot records the mtime, inode and size of every entry in the build output,
+// it is used by incremental builds to find the entries changed since the last commit.
+class InstallSnapshot
+{
+public:
+    struct Stamp
+    {
+        int64_t mtime{ 0 }; // nanoseconds
+        uint64_t inode{ 0 };
+        int64_t size{ 0 };
+
+        bool operator==(const Stamp &other) const noexcept
+        {
+            return mtime == other.mtime && inode == other.inode && size == other.size;
+        }
+
+        bool operator!=(const Stamp &other) const noexcept { return !(*this == other); }
+    };
+
+    // paths of entries are relative to root and start with '/', e.g. "/bin/demo"
+    static utils::error::Result<InstallSnapshot> scan(const std::filesystem::path &root) noexcept;
+    static utils::error::Result<InstallSnapshot> load(const std::filesystem::path &file) noexcept;
+    utils::error::Result<void> save(const std::filesystem::path &file) const noexcept;
+
+    // entries which are new or whose stamp differs from the one in previous
+    [[nodiscard]] std::vector<std::string>
+    changedSince(const InstallSnapshot &previous) const noexcept;
+    // entries of previous which don't exist anymore, children are ordered before their parent
+    [[nodiscard]] std::vector<std::string>
+    removedSince(const InstallSnapshot &previous) const noexcept;
+    [[nodiscard]] std::vector<std::string> entries() const noexcept;
+
+    // digest of the install rules used to split the entries into modules,
+    // a snapshot is only comparable with snapshots using the same rules
+    std::string rulesDigest;
+
+private:
+    std::map<std::string, Stamp> stamps;
+};
+
+} // namespace linglong::builder
@@ -9,6 +9,7 @@
 #include "configure.h"
 #include "linglong/api/types/v1/ExportDirs.hpp"
 #include "linglong/api/types/v1/Generators.hpp"
+#include "linglong/builder/output_checker.h"
 #include "linglong/builder/printer.h"
 #include "linglong/common/xdg.h"
 #include "linglong/package/architecture.h"
@@ -20,12 +21,15 @@
 #include "linglong/repo/ostree_repo.h"
 #include "linglong/runtime/container.h"
 #include "linglong/utils/command/cmd.h"
+#include "linglong/utils/disk_space.h"
 #include "linglong/utils/error/error.h"
 #include "linglong/utils/file.h"
+#include "linglong/utils/finally/finally.h"
 #include "linglong/utils/global/initialize.h"
 #include "linglong/utils/log/log.h"
 #include "linglong/utils/packageinfo_handler.h"
 #include "linglong/utils/serialize/json.h"
+#include "linglong/utils/trace/span.h"
 #include "ocppi/runtime/RunOption.hpp"
 #include "source_fetcher.h"
 
@@ -49,13 +53,17 @@
 #include <QUuid>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <map>
 #include <optional>
 #include <ostream>
+#include <set>
 #include <string>
 #include <system_error>
 #include <vector>
@@ -158,11 +166,15 @@ utils::error::Result<void>
 fetchSources(const std::vector<api::types::v1::BuilderProjectSource> &sources,
              const QDir &cacheDir,
              const QDir &destination,
-             const api::types::v1::BuilderConfig &cfg) noexcept
+             const api::types::v1::BuilderConfig &cfg,
+             const std::atomic_bool *cancelled = nullptr) noexcept
 {
     LINGLONG_TRACE("fetch sources to " + destination.absolutePath());
 
     for (decltype(sources.size()) pos = 0; pos < sources.size(); ++pos) {
+        if (cancelled != nullptr && cancelled->load()) {
+            return LINGLONG_ERR("fetching sources is cancelled");
+        }
         if (!sources.at(pos).url.has_value()) {
             return LINGLONG_ERR("source missing url");
         }
@@ -178,6 +190,8 @@ fetchSources(const std::vector<api::types::v1::BuilderProjectSource> &sources,
                             .toStdString(),
                           2);
         SourceFetcher fetcher(sources.at(pos), cacheDir);
+        // git mirrors are shared by all projects of the user
+        fetcher.setGitMirrorDir(QDir(QString::fromStdString(cfg.repo)).filePath("git-mirrors"));
         auto result = fetcher.fetch(QDir(destination));
         if (!result) {
             return LINGLONG_ERR(result);
@@ -196,7 +210,8 @@ fetchSources(const std::vector<api::types::v1::BuilderProjectSource> &sources,
 
 utils::error::Result<void> pullDependency(const package::Reference &ref,
                                           repo::OSTreeRepo &repo,
-                                          const std::string &module) noexcept
+                                          const std::string &module,
+                                          GCancellable *cancellable = nullptr) noexcept
 {
     LINGLONG_TRACE("pull " + ref.toString());
 
@@ -206,6 +221,22 @@ utils::error::Result<void> pullDependency(const package::Reference &ref,
     }
 
     auto tmpTask = service::PackageTask::createTemporaryTask();
+    // cancelling the build cancels the pull, the callback may be called from another thread
+    gulong cancelHandler = 0;
+    if (cancellable != nullptr) {
+        cancelHandler = g_cancellable_connect(
+          cancellable,
+          G_CALLBACK(+[](GCancellable *, gpointer data) {
+              g_cancellable_cancel(static_cast<GCancellable *>(data));
+          }),
+          tmpTask.cancellable(),
+          nullptr);
+    }
+    auto disconnect = utils::finally::finally([cancellable, cancelHandler] {
+        if (cancellable != nullptr) {
+            g_cancellable_disconnect(cancellable, cancelHandler);
+        }
+    });
     auto partChanged = [&ref, module](const uint fetched, const uint requested) {
         auto percentage = (uint)((((double)fetched) / requested) * 100);
         auto progress = QString("(%1/%2 %3%)").arg(fetched).arg(requested).arg(percentage);
@@ -233,10 +264,21 @@ utils::error::Result<void> pullDependency(const package::Reference &ref,
     return LINGLONG_OK;
 }
 
+// state of an incremental install, paths are relative to the build output, e.g. "/bin/demo"
+struct IncrementalInstall
+{
+    // entries changed since the last commit, only these are installed
+    std::set<QString> changed;
+    // files already installed to a module, a file is installed to the first module matching it
+    std::set<QString> installed;
+};
+
 // 安装模块文件
+// 默认将文件移动到模块目录，增量构建时保留构建输出，仅复制变更的文件
 utils::error::Result<void> installModule(QStringList installRules,
                                          const QDir &buildOutput,
-                                         const QDir &moduleOutput)
+                                         const QDir &moduleOutput,
+                                         IncrementalInstall *incremental = nullptr)
 {
     LINGLONG_TRACE("install module file");
     buildOutput.mkpath(".");
@@ -249,11 +291,27 @@ utils::error::Result<void> installModule(QStringList installRules,
                            const QString &dstPath) -> utils::error::Result<void> {
         LINGLONG_TRACE("install file");
 
+        if (incremental != nullptr) {
+            auto path = info.absoluteFilePath().mid(src.length());
+            if (incremental->changed.count(path) == 0) {
+                return LINGLONG_OK;
+            }
+            if (!info.isDir() || info.isSymLink()) {
+                if (!incremental->installed.insert(path).second) {
+                    return LINGLONG_OK;
+                }
+            }
+        }
+
         if (info.isDir()) {
             if (!info.isSymLink()) {
                 QDir().mkpath(dstPath);
                 return LINGLONG_OK;
             }
+            if (incremental != nullptr) {
+                std::error_code ec;
+                std::filesystem::remove(dstPath.toStdString(), ec);
+            }
             std::error_code ec;
             auto target = std::filesystem::read_symlink(info.filePath().toStdString());
             std::filesystem::create_symlink(target, dstPath.toStdString(), ec);
@@ -271,7 +329,21 @@ utils::error::Result<void> installModule(QStringList installRules,
               QString("Failed to create directory: %1").arg(dstDir.absolutePath()));
         }
 
-        QFile::rename(info.filePath(), dstPath);
+        if (incremental == nullptr) {
+            QFile::rename(info.filePath(), dstPath);
+            return LINGLONG_OK;
+        }
+
+        std::error_code ec;
+        std::filesystem::remove(dstPath.toStdString(), ec);
+        std::filesystem::copy(info.filePath().toStdString(),
+                              dstPath.toStdString(),
+                              std::filesystem::copy_options::copy_symlinks,
+                              ec);
+        if (ec) {
+            return LINGLONG_ERR(
+              QString("Failed to copy %1: %2").arg(info.filePath(), ec.message().c_str()));
+        }
         return LINGLONG_OK;
     };
 
@@ -306,6 +378,20 @@ utils::error::Result<void> installModule(QStringList installRules,
             rule = "^" + src + "/" + rule.mid(1);
         }
         QRegularExpression regexp(rule);
+        // only changed entries need to be matched in incremental install
+        if (incremental != nullptr) {
+            for (const auto &path : incremental->changed) {
+                QFileInfo info(src + path);
+                if (regexp.match(info.absoluteFilePath()).hasMatch()) {
+                    const QString dstPath = dest + path;
+                    auto ret = installFile(info, dstPath);
+                    if (!ret.has_value()) {
+                        return LINGLONG_ERR(ret);
+                    }
+                }
+            }
+            continue;
+        }
         // reverse files in src
         QDirIterator iter(src,
                           QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System,
@@ -325,6 +411,107 @@ utils::error::Result<void> installModule(QStringList installRules,
     return LINGLONG_OK;
 }
 
+// snapshot of the build output saved after commit, used by incremental build
+constexpr auto InstallSnapshotFile = ".install-snapshot.json";
+
+// ld caches shared by builds are mounted here in the build container
+constexpr auto LDCacheMountPoint = "/run/linglong/ld-cache";
+
+// ld.so.cache only depends on the layers and the ld.so.conf, so it's generated once and
+// reused by every build and run using the same ones
+utils::error::Result<std::filesystem::path> ldCacheFile(const std::filesystem::path &cacheDir,
+                                                        runtime::RunContext &context,
+                                                        const std::string &ldConf,
+                                                        const std::string &extra = {})
+{
+    LINGLONG_TRACE("get ld cache file");
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(QByteArray::fromStdString(ldConf));
+    hash.addData(QByteArray::fromStdString(extra));
+    for (const auto *layer :
+         { &context.getBaseLayer(), &context.getRuntimeLayer(), &context.getAppLayer() }) {
+        if (!layer->has_value()) {
+            continue;
+        }
+        auto item = context.getRepo().getLayerItem((*layer)->getReference());
+        if (!item) {
+            return LINGLONG_ERR(item);
+        }
+        hash.addData(QByteArray::fromStdString(item->commit));
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDir, ec);
+    if (ec) {
+        return LINGLONG_ERR(
+          fmt::format("failed to create ld cache dir {}: {}", cacheDir, ec.message()).c_str());
+    }
+
+    return cacheDir / hash.result().toHex().toStdString();
+}
+
+// save the generated ld cache, it's written to a temporary file first because other builds
+// may read the cache at the same time
+void storeLDCache(const std::filesystem::path &generated, const std::filesystem::path &cacheFile)
+{
+    auto tmpFile = cacheFile;
+    tmpFile += ".tmp";
+
+    std::error_code ec;
+    std::filesystem::copy_file(generated,
+                               tmpFile,
+                               std::filesystem::copy_options::overwrite_existing,
+                               ec);
+    if (!ec) {
+        std::filesystem::rename(tmpFile, cacheFile, ec);
+    }
+    if (ec) {
+        LogW("failed to store ld cache {}: {}", cacheFile, ec.message());
+        std::filesystem::remove(tmpFile, ec);
+    }
+}
+
+// the compiler cache is mounted here in the build container
+constexpr auto CompilerCacheMountPoint = "/var/cache/linglong-compiler-cache";
+
+// generate the part of entry script which enables ccache or sccache,
+// the statistics of the cache are printed when the build exits
+std::string compilerCacheScript(const std::string &tool)
+{
+    std::string script = fmt::format("\n# enable compiler cache\n"
+                                     "if command -v {0} >/dev/null; then\n",
+                                     tool);
+    if (tool == "ccache") {
+        script.append(fmt::format("    export CCACHE_DIR={0}\n"
+                                  "    export CCACHE_BASEDIR=/project\n"
+                                  "    if [ -d /usr/lib/ccache ]; then\n"
+                                  "        export PATH=\"/usr/lib/ccache:$PATH\"\n"
+                                  "    else\n"
+                                  "        export CMAKE_C_COMPILER_LAUNCHER=ccache\n"
+                                  "        export CMAKE_CXX_COMPILER_LAUNCHER=ccache\n"
+                                  "    fi\n"
+                                  "    ccache -z >/dev/null\n"
+                                  "    trap 'ccache -s' EXIT\n",
+                                  CompilerCacheMountPoint));
+    } else {
+        // stopping the server prints the statistics and lets the container exit
+        script.append(fmt::format("    export SCCACHE_DIR={0}\n"
+                                  "    export RUSTC_WRAPPER=sccache\n"
+                                  "    export CMAKE_C_COMPILER_LAUNCHER=sccache\n"
+                                  "    export CMAKE_CXX_COMPILER_LAUNCHER=sccache\n"
+                                  "    sccache --zero-stats >/dev/null\n"
+                                  "    trap 'sccache --stop-server' EXIT\n",
+                                  CompilerCacheMountPoint));
+    }
+    script.append(fmt::format("else\n"
+                              "    echo \"{0} not found, compiler cache is disabled\" >&2\n"
+                              "fi\n",
+                              tool));
+
+    return script;
+}
+
 } // namespace
 
 utils::error::Result<void> cmdListApp(repo::OSTreeRepo &repo)
@@ -416,7 +603,7 @@ void Builder::setConfig(const api::types::v1::BuilderConfig &cfg) noexcept
 
 utils::error::Result<void> Builder::buildStagePrepare() noexcept
 {
-    LINGLONG_TRACE("build prepare");
+    LINGLONG_TRACE_SPAN("build prepare");
 
     uid = getuid();
     gid = getgid();
@@ -465,9 +652,10 @@ utils::error::Result<void> Builder::buildStagePrepare() noexcept
     return LINGLONG_OK;
 }
 
-utils::error::Result<void> Builder::buildStageFetchSource() noexcept
+utils::error::Result<void>
+Builder::buildStageFetchSource(const std::atomic_bool *cancelled) noexcept
 {
-    LINGLONG_TRACE("build stage fetch source");
+    LINGLONG_TRACE_SPAN("build stage fetch source");
 
     if (!this->project->sources || this->buildOptions.skipFetchSource) {
         return LINGLONG_OK;
@@ -488,7 +676,8 @@ utils::error::Result<void> Builder::buildStageFetchSource() noexcept
     // clean sources directory on every build
     auto fetchSourcesDir = QDir(QString::fromStdString(internalDir / "sources"));
     fetchSourcesDir.removeRecursively();
-    auto result = fetchSources(*this->project->sources, fetchCacheDir, fetchSourcesDir, this->cfg);
+    auto result =
+      fetchSources(*this->project->sources, fetchCacheDir, fetchSourcesDir, this->cfg, cancelled);
 
     if (!result) {
         return LINGLONG_ERR(result);
@@ -566,9 +755,9 @@ utils::error::Result<package::Reference> Builder::clearDependency(const std::str
     return res;
 }
 
-utils::error::Result<void> Builder::buildStagePullDependency() noexcept
+utils::error::Result<void> Builder::buildStagePullDependency(GCancellable *cancellable) noexcept
 {
-    LINGLONG_TRACE("build stage pull dependency");
+    LINGLONG_TRACE_SPAN("build stage pull dependency");
 
     printMessage("[Processing Dependency]");
     printMessage(QString("%1%2%3%4")
@@ -595,7 +784,7 @@ utils::error::Result<void> Builder::buildStagePullDependency() noexcept
     }
 
     if (!this->buildOptions.skipPullDepend) {
-        auto ref = pullDependency(*baseRef, this->repo, "binary");
+        auto ref = pullDependency(*baseRef, this->repo, "binary", cancellable);
         if (!ref.has_value()) {
             return LINGLONG_ERR("failed to pull base binary " + baseRef->toString(), ref);
         }
@@ -608,7 +797,7 @@ utils::error::Result<void> Builder::buildStagePullDependency() noexcept
                             .toStdString(),
                           2);
 
-        ref = pullDependency(*baseRef, this->repo, "develop");
+        ref = pullDependency(*baseRef, this->repo, "develop", cancellable);
         if (!ref.has_value()) {
             return LINGLONG_ERR("failed to pull base develop " + baseRef->toString(), ref);
         }
@@ -622,7 +811,7 @@ utils::error::Result<void> Builder::buildStagePullDependency() noexcept
                           2);
 
         if (runtimeRef) {
-            ref = pullDependency(*runtimeRef, this->repo, "binary");
+            ref = pullDependency(*runtimeRef, this->repo, "binary", cancellable);
             if (!ref.has_value()) {
                 return LINGLONG_ERR("failed to pull runtime binary " + runtimeRef->toString(), ref);
             }
@@ -635,7 +824,7 @@ utils::error::Result<void> Builder::buildStagePullDependency() noexcept
                                 .toStdString(),
                               2);
 
-            ref = pullDependency(*runtimeRef, this->repo, "develop");
+            ref = pullDependency(*runtimeRef, this->repo, "develop", cancellable);
             if (!ref.has_value()) {
                 return LINGLONG_ERR("failed to pull runtime develop " + runtimeRef->toString(),
                                     ref);
@@ -762,12 +951,49 @@ utils::error::Result<void> Builder::processBuildDepends() noexcept
     return LINGLONG_OK;
 }
 
+utils::error::Result<std::filesystem::path> Builder::compilerCacheDir() noexcept
+{
+    LINGLONG_TRACE("get compiler cache dir");
+
+    auto cacheDir = internalDir / "compiler-cache" / this->buildOptions.compilerCache;
+    if (this->buildOptions.sharedCompilerCache) {
+        // objects compiled against different base or runtime can't be reused, so the shared
+        // cache is keyed by their commits
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        for (const auto *layer :
+             { &buildContext.getBaseLayer(), &buildContext.getRuntimeLayer() }) {
+            if (!layer->has_value()) {
+                continue;
+            }
+            auto item = this->repo.getLayerItem((*layer)->getReference());
+            if (!item) {
+                return LINGLONG_ERR(item);
+            }
+            hash.addData(QByteArray::fromStdString(item->commit));
+        }
+        cacheDir = std::filesystem::path{ this->cfg.repo } / "compiler-cache"
+          / this->buildOptions.compilerCache / hash.result().toHex().toStdString();
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDir, ec);
+    if (ec) {
+        return LINGLONG_ERR(
+          fmt::format("failed to create compiler cache dir {}: {}", cacheDir, ec.message())
+            .c_str());
+    }
+
+    return cacheDir;
+}
+
 utils::error::Result<void> Builder::buildStagePreBuild() noexcept
 {
-    LINGLONG_TRACE("build stage pre build");
+    LINGLONG_TRACE_SPAN("build stage pre build");
 
-    // clean output
-    QDir(QString::fromStdString(internalDir / "output")).removeRecursively();
+    // clean output, incremental build keeps the build output and modules of last build
+    if (!this->buildOptions.incremental) {
+        QDir(QString::fromStdString(internalDir / "output")).removeRecursively();
+    }
 
     buildOutput.setPath(QString::fromStdString(internalDir / "output" / "_build"));
     if (!buildOutput.mkpath(".")) {
@@ -814,7 +1040,7 @@ utils::error::Result<void> Builder::buildStagePreBuild() noexcept
 
 utils::error::Result<bool> Builder::buildStageBuild(const QStringList &args) noexcept
 {
-    LINGLONG_TRACE("build stage build");
+    LINGLONG_TRACE_SPAN("build stage build");
 
     if (this->buildOptions.skipRunContainer) {
         return false;
@@ -849,10 +1075,6 @@ utils::error::Result<bool> Builder::buildStageBuild(const QStringList &args) noe
     cfgBuilder.setAppId(this->project->package.id)
       .setBasePath(baseOverlay->mergedDirPath(), false)
       .bindDefault()
-      .setStartContainerHooks(
-        std::vector<ocppi::runtime::config::types::Hook>{ ocppi::runtime::config::types::Hook{
-          .path = "/sbin/ldconfig",
-        } })
       .forwardDefaultEnv()
       .addMask({
         "/project/linglong/output",
@@ -883,6 +1105,53 @@ utils::error::Result<bool> Builder::buildStageBuild(const QStringList &args) noe
     // must be closed here, this conf will be used later.
     ldsoconf.close();
 
+    // Reuse the ld cache generated by previous builds instead of running ldconfig every time.
+    // Packages of buildext are installed to the base overlay, so they are part of the key.
+    // The cache can't be used if the build output isn't empty, e.g. in incremental build,
+    // because the libraries in it aren't included.
+    auto ldConfigHook = ocppi::runtime::config::types::Hook{ .path = "/sbin/ldconfig" };
+    auto ldCache = ldCacheFile(std::filesystem::path{ this->cfg.repo } / "ld-cache",
+                               buildContext,
+                               ldRawConf,
+                               this->project->buildext
+                                 ? nlohmann::json(*this->project->buildext).dump()
+                                 : std::string{});
+    if (!ldCache) {
+        qWarning() << "ld cache is disabled:" << ldCache.error().message();
+    } else if (!buildOutput.isEmpty()) {
+        qDebug() << "build output isn't empty, ld cache is not used";
+    } else if (std::filesystem::exists(*ldCache)) {
+        qDebug() << "use ld cache" << ldCache->c_str();
+        std::error_code ec;
+        std::filesystem::copy_file(*ldCache,
+                                   baseOverlay->mergedDirPath() / "etc" / "ld.so.cache",
+                                   std::filesystem::copy_options::overwrite_existing,
+                                   ec);
+        if (ec) {
+            return LINGLONG_ERR(QString("failed to copy ld cache: %1").arg(ec.message().c_str()));
+        }
+        ldConfigHook = {};
+    } else {
+        // the hook saves the generated cache for the following builds
+        auto cacheFile = std::string{ LDCacheMountPoint } + "/" + ldCache->filename().string();
+        ldConfigHook = ocppi::runtime::config::types::Hook{
+            .args = std::vector<std::string>{ "/bin/sh",
+                                              "-c",
+                                              "/sbin/ldconfig && { cp /etc/ld.so.cache "
+                                                + cacheFile + ".tmp && mv -f " + cacheFile
+                                                + ".tmp " + cacheFile + " || true; }" },
+            .path = "/bin/sh",
+        };
+        cfgBuilder.addExtraMount(
+          ocppi::runtime::config::types::Mount{ .destination = LDCacheMountPoint,
+                                                .options = { { "rbind", "rw" } },
+                                                .source = ldCache->parent_path(),
+                                                .type = "bind" });
+    }
+    if (!ldConfigHook.path.empty()) {
+        cfgBuilder.setStartContainerHooks({ ldConfigHook });
+    }
+
     cfgBuilder.addExtraMounts(std::vector<ocppi::runtime::config::types::Mount>{
       ocppi::runtime::config::types::Mount{ .destination = LINGLONG_BUILDER_HELPER,
                                             .options = { { "rbind", "ro" } },
@@ -898,6 +1167,19 @@ utils::error::Result<bool> Builder::buildStageBuild(const QStringList &args) noe
                                             .source = ldConfPath.toStdString(),
                                             .type = "bind" } });
 
+    if (!this->buildOptions.compilerCache.empty()) {
+        auto cacheDir = compilerCacheDir();
+        if (!cacheDir) {
+            return LINGLONG_ERR(cacheDir);
+        }
+        printMessage("Compiler cache: " + cacheDir->string(), 2);
+        cfgBuilder.addExtraMount(
+          ocppi::runtime::config::types::Mount{ .destination = CompilerCacheMountPoint,
+                                                .options = { { "rbind", "rw" } },
+                                                .source = *cacheDir,
+                                                .type = "bind" });
+    }
+
     if (!cfgBuilder.build()) {
         auto err = cfgBuilder.getError();
         return LINGLONG_ERR("build cfg error: " + QString::fromStdString(err.reason));
@@ -943,7 +1225,7 @@ utils::error::Result<bool> Builder::buildStageBuild(const QStringList &args) noe
 
 utils::error::Result<void> Builder::buildStagePreCommit() noexcept
 {
-    LINGLONG_TRACE("build stage pre commit");
+    LINGLONG_TRACE_SPAN("build stage pre commit");
 
     auto &project = *this->project;
 
@@ -1087,15 +1369,6 @@ utils::error::Result<void> Builder::installFiles() noexcept
                    .arg("Status")
                    .toStdString(),
                  2);
-    // 保存全量的develop, runtime需要对旧的ll-builder保持兼容
-    if (this->buildOptions.fullDevelop) {
-        QDir moduleDir(QString::fromStdString(internalDir / "output" / "develop" / "files"));
-        auto ret = copyDir(buildOutput.path(), moduleDir.path());
-        if (!ret) {
-            return LINGLONG_ERR("failed to install full develop files", ret);
-        }
-    }
-
     std::vector<api::types::v1::BuilderProjectModules> projectModules;
     auto hasDevelop = false;
     auto hasBinary = false;
@@ -1124,6 +1397,31 @@ utils::error::Result<void> Builder::installFiles() noexcept
         }
     }
 
+    std::optional<IncrementalInstall> incremental;
+    if (this->buildOptions.incremental) {
+        auto changed = prepareIncrementalInstall(projectModules);
+        if (!changed) {
+            return LINGLONG_ERR("failed to prepare incremental install", changed);
+        }
+        incremental.emplace();
+        for (const auto &path : *changed) {
+            incremental->changed.insert(QString::fromStdString(path));
+        }
+    }
+    auto *incrementalPtr = incremental ? &*incremental : nullptr;
+
+    // 保存全量的develop, runtime需要对旧的ll-builder保持兼容
+    if (this->buildOptions.fullDevelop) {
+        QDir moduleDir(QString::fromStdString(internalDir / "output" / "develop" / "files"));
+        if (this->buildOptions.incremental) {
+            moduleDir.removeRecursively();
+        }
+        auto ret = copyDir(buildOutput.path(), moduleDir.path());
+        if (!ret) {
+            return LINGLONG_ERR("failed to install full develop files", ret);
+        }
+    }
+
     for (const auto &module : projectModules) {
         auto name = QString::fromStdString(module.name);
         printReplacedText(QString("%1%2%3%4")
@@ -1140,7 +1438,10 @@ utils::error::Result<void> Builder::installFiles() noexcept
             installRules.append(file.c_str());
         }
         installRules.removeDuplicates();
-        auto ret = installModule(installRules, buildOutput.path(), moduleDir.filePath("files"));
+        auto ret = installModule(installRules,
+                                 buildOutput.path(),
+                                 moduleDir.filePath("files"),
+                                 incrementalPtr);
         if (!ret.has_value()) {
             return LINGLONG_ERR("install module", ret);
         }
@@ -1200,7 +1501,10 @@ utils::error::Result<void> Builder::installFiles() noexcept
                             .toStdString(),
                           2);
         QDir moduleDir(QString::fromStdString(internalDir / "output" / "binary"));
-        auto ret = installModule(installRules, buildOutput.path(), moduleDir.filePath("files"));
+        auto ret = installModule(installRules,
+                                 buildOutput.path(),
+                                 moduleDir.filePath("files"),
+                                 incrementalPtr);
         if (!ret.has_value()) {
             return LINGLONG_ERR("install module", ret);
         }
@@ -1227,6 +1531,92 @@ utils::error::Result<void> Builder::installFiles() noexcept
     return LINGLONG_OK;
 }
 
+utils::error::Result<std::vector<std::string>> Builder::prepareIncrementalInstall(
+  const std::vector<api::types::v1::BuilderProjectModules> &modules) noexcept
+{
+    LINGLONG_TRACE("prepare incremental install");
+
+    auto &project = *this->project;
+    auto outputDir = internalDir / "output";
+
+    // files are split into modules by these rules, if they changed all files must be installed
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(QByteArray::fromStdString(nlohmann::json(modules).dump()));
+    QFile installRuleFile(
+      QString::fromStdString(this->workingDir / (project.package.id + ".install")));
+    if (installRuleFile.open(QIODevice::ReadOnly)) {
+        hash.addData(installRuleFile.readAll());
+    }
+    if (this->buildOptions.fullDevelop) {
+        hash.addData(QByteArray("full-develop"));
+    }
+
+    auto current = InstallSnapshot::scan(buildOutput.absolutePath().toStdString());
+    if (!current) {
+        return LINGLONG_ERR(current);
+    }
+    current->rulesDigest = hash.result().toHex().toStdString();
+
+    std::vector<std::string> changed;
+    auto previous = InstallSnapshot::load(outputDir / InstallSnapshotFile);
+    auto reinstall = !previous || previous->rulesDigest != current->rulesDigest;
+    if (reinstall) {
+        qDebug() << "install rules changed or no install snapshot, install all files";
+        changed = current->entries();
+    } else {
+        changed = current->changedSince(*previous);
+        // entries removed from the build output are removed from the modules too
+        for (const auto &path : current->removedSince(*previous)) {
+            for (const auto &module : std::as_const(packageModules)) {
+                std::error_code ec;
+                std::filesystem::remove(outputDir / module.toStdString() / "files"
+                                          / std::filesystem::path(path).relative_path(),
+                                        ec);
+            }
+        }
+    }
+    qDebug() << "incremental install" << changed.size() << "of" << current->entries().size()
+             << "entries";
+
+    // files of modules are kept, everything else is generated again
+    std::vector<std::filesystem::path> outdated;
+    std::error_code ec;
+    for (auto iter = std::filesystem::directory_iterator(outputDir, ec);
+         !ec && iter != std::filesystem::directory_iterator();
+         iter.increment(ec)) {
+        if (!iter->is_directory() || iter->path().filename() == "_build") {
+            continue;
+        }
+        if (reinstall) {
+            outdated.push_back(iter->path());
+            continue;
+        }
+        for (auto entry = std::filesystem::directory_iterator(iter->path(), ec);
+             !ec && entry != std::filesystem::directory_iterator();
+             entry.increment(ec)) {
+            if (entry->path().filename() != "files") {
+                outdated.push_back(entry->path());
+            }
+        }
+        if (ec) {
+            break;
+        }
+    }
+    if (ec) {
+        return LINGLONG_ERR(fmt::format("failed to list {}: {}", outputDir, ec.message()).c_str());
+    }
+
+    for (const auto &path : outdated) {
+        std::filesystem::remove_all(path, ec);
+        if (ec) {
+            return LINGLONG_ERR(fmt::format("failed to remove {}: {}", path, ec.message()).c_str());
+        }
+    }
+
+    this->installSnapshot = std::move(current).value();
+    return changed;
+}
+
 utils::error::Result<void> Builder::generateEntries() noexcept
 {
     LINGLONG_TRACE("generate entries");
@@ -1420,9 +1810,41 @@ utils::error::Result<void> Builder::commitToLocalRepo() noexcept
     return LINGLONG_OK;
 }
 
+// The size of the build output is only known after pre commit, so the space is checked here
+// instead of failing in the middle of installing or committing the modules.
+utils::error::Result<void> Builder::checkCommitSpace() noexcept
+{
+    LINGLONG_TRACE("check space for commit");
+
+    auto usage = utils::directoryUsage(buildOutput.absolutePath().toStdString());
+    if (!usage) {
+        return LINGLONG_ERR(usage);
+    }
+
+    // files are moved from the build output to the modules, but they are copied in incremental
+    // build and for the full develop module
+    std::vector<utils::SpaceRequirement> requirements;
+    uintmax_t copies = 0;
+    if (this->buildOptions.incremental) {
+        ++copies;
+    }
+    if (this->buildOptions.fullDevelop) {
+        ++copies;
+    }
+    if (copies > 0) {
+        requirements.push_back({ internalDir / "output",
+                                 usage->bytes * copies,
+                                 usage->inodes * copies });
+    }
+    // committing the modules writes every file to the objects of the local repo once
+    requirements.push_back({ this->cfg.repo, usage->bytes, usage->inodes });
+
+    return utils::checkDiskSpace(requirements);
+}
+
 utils::error::Result<bool> Builder::buildStageCommit() noexcept
 {
-    LINGLONG_TRACE("build stage commit");
+    LINGLONG_TRACE_SPAN("build stage commit");
 
     if (this->buildOptions.skipCommitOutput) {
         return false;
@@ -1433,6 +1855,10 @@ utils::error::Result<bool> Builder::buildStageCommit() noexcept
         return LINGLONG_ERR("stage pre commit failed", res);
     }
 
+    if (!(res = checkCommitSpace())) {
+        return LINGLONG_ERR(res);
+    }
+
     if (!(res = generateAppConf())) {
         return LINGLONG_ERR("failed to generate app conf", res);
     }
@@ -1449,12 +1875,21 @@ utils::error::Result<bool> Builder::buildStageCommit() noexcept
         return LINGLONG_ERR("failed to commit to local repo", res);
     }
 
+    // next incremental build only installs the entries changed after this commit
+    if (this->installSnapshot) {
+        auto ret = this->installSnapshot->save(internalDir / "output" / InstallSnapshotFile);
+        if (!ret) {
+            qWarning() << "failed to save install snapshot:" << ret.error().message();
+        }
+        this->installSnapshot.reset();
+    }
+
     return true;
 }
 
 utils::error::Result<void> Builder::build(const QStringList &args) noexcept
 {
-    LINGLONG_TRACE(
+    LINGLONG_TRACE_SPAN(
       QString("build project %1").arg(QString::fromStdString(this->workingDir / "linglong.yaml")));
 
     auto &project = *this->project;
@@ -1463,11 +1898,31 @@ utils::error::Result<void> Builder::build(const QStringList &args) noexcept
         return LINGLONG_ERR("stage prepare error", res);
     }
 
-    if (!(res = buildStageFetchSource())) {
-        return LINGLONG_ERR("stage fetch srouce error", res);
+    // Sources and dependencies are downloaded from different servers, so sources are fetched
+    // in another thread while pulling dependencies. The stage failed first cancels the other.
+    std::atomic_bool fetchCancelled{ false };
+    g_autoptr(GCancellable) pullCancellable = g_cancellable_new();
+    auto fetching = std::async(std::launch::async, [this, &fetchCancelled, &pullCancellable]() {
+        auto ret = buildStageFetchSource(&fetchCancelled);
+        if (!ret) {
+            g_cancellable_cancel(pullCancellable);
+        }
+        return ret;
+    });
+
+    res = buildStagePullDependency(pullCancellable);
+    if (!res) {
+        fetchCancelled = true;
     }
+    auto fetched = fetching.get();
+    // clear the progress line left by a failed stage
+    printReplacedText("");
 
-    if (!(res = buildStagePullDependency())) {
+    if (!fetched) {
+        return LINGLONG_ERR("stage fetch srouce error", fetched);
+    }
+
+    if (!res) {
         return LINGLONG_ERR("stage pull dependency error", res);
     }
 
@@ -1500,15 +1955,24 @@ utils::error::Result<void> Builder::build(const QStringList &args) noexcept
 utils::error::Result<void> Builder::exportUAB(const ExportOption &option,
                                               const std::filesystem::path &outputFile)
 {
-    LINGLONG_TRACE("export uab file");
+    LINGLONG_TRACE_SPAN("export uab file");
 
     auto exportWorkingDir = this->workingDir / ".uabBuild";
     package::UABPackager packager{ QDir(QString::fromStdString(workingDir)),
                                    QString::fromStdString(exportWorkingDir) };
     auto exportOpts = option;
+    utils::error::Result<package::ErofsProfile> erofsProfile = package::defaultErofsProfile();
+    if (!exportOpts.erofsProfile.empty()) {
+        erofsProfile = package::erofsProfile(exportOpts.erofsProfile);
+    }
+    if (!erofsProfile) {
+        return LINGLONG_ERR(erofsProfile);
+    }
+    packager.setErofsProfile(*erofsProfile);
     if (exportOpts.compressor.empty()) {
-        qInfo() << "Compressor not specified, defaulting to lz4 for UAB export.";
-        exportOpts.compressor = "lz4";
+        qInfo() << "Compressor not specified, defaulting to" << erofsProfile->compressor.c_str()
+                << "of erofs profile" << erofsProfile->name.c_str() << "for UAB export.";
+        exportOpts.compressor = erofsProfile->compressor;
     }
 
     if (exportOpts.modules.empty()) {
@@ -1552,8 +2016,9 @@ utils::error::Result<void> Builder::exportUAB(const ExportOption &option,
         }
 
         auto utilsBundler =
-          [&ref, &exportOpts, this](const QString &bundleFile,
-                                    const QString &bundleDir) -> utils::error::Result<void> {
+          [&ref, &exportOpts, &erofsProfile, this](
+            const QString &bundleFile,
+            const QString &bundleDir) -> utils::error::Result<void> {
             LINGLONG_TRACE("use utils to bundle file");
 
             std::error_code ec;
@@ -1585,6 +2050,13 @@ utils::error::Result<void> Builder::exportUAB(const ExportOption &option,
 
             args.emplace_back("-z");
             args.emplace_back(exportOpts.compressor);
+            // older utils only know the parameters of the default profile
+            if (!exportOpts.erofsProfile.empty()) {
+                for (const auto &option : erofsProfile->options) {
+                    args.emplace_back("--mkfs-option");
+                    args.emplace_back(option);
+                }
+            }
             return runFromRepo(*ref, args);
         };
         packager.setBundleCB(utilsBundler);
@@ -1759,7 +2231,7 @@ utils::error::Result<void> Builder::exportUAB(const ExportOption &option,
 
 utils::error::Result<void> Builder::exportLayer(const ExportOption &option)
 {
-    LINGLONG_TRACE("export layer file");
+    LINGLONG_TRACE_SPAN("export layer file");
 
     auto &project = *this->project;
     auto ref = currentReference(project);
@@ -1776,6 +2248,8 @@ utils::error::Result<void> Builder::exportLayer(const ExportOption &option)
     if (!option.compressor.empty()) {
         pkger.setCompressor(option.compressor.c_str());
     }
+    // most modules are unchanged between versions, their images are reused
+    pkger.setImageCacheDir(std::filesystem::path{ this->cfg.repo } / "layer-cache");
     for (const auto &module : modules) {
         if (option.noExportDevelop && module == "develop") {
             continue;
@@ -1794,7 +2268,17 @@ utils::error::Result<void> Builder::exportLayer(const ExportOption &option)
                                 ref->version.toString(),
                                 ref->arch.toString(),
                                 module.c_str());
-        auto ret = pkger.pack(*layerDir, layerFile);
+        // the content checksum of the commit avoids hashing the whole layer dir
+        std::optional<std::string> contentDigest;
+        auto layerItem = this->repo.getLayerItem(*ref, module);
+        if (layerItem) {
+            auto checksum = this->repo.getCommitContentChecksum(layerItem->commit);
+            if (checksum) {
+                contentDigest = std::move(checksum).value();
+            }
+        }
+
+        auto ret = pkger.pack(*layerDir, layerFile, contentDigest);
         if (!ret) {
             qCritical().nospace() << "export layer " << ref->toString() << "/" << module.c_str()
                                   << " failed: " << ret.error().message();
@@ -2003,25 +2487,49 @@ utils::error::Result<void> Builder::run(const QStringList &modules,
         // must be closed here, this conf will be used later.
         ldsoconf.close();
 
-        if (!cfgBuilder.build()) {
-            auto err = cfgBuilder.getError();
-            return LINGLONG_ERR("build cfg error: " + QString::fromStdString(err.reason));
+        auto ldCache = ldCacheFile(std::filesystem::path{ this->cfg.repo } / "ld-cache",
+                                   runContext,
+                                   ldRawConf,
+                                   (debug ? "debug:" : "") + modules.join(",").toStdString());
+        if (!ldCache) {
+            qWarning() << "ld cache is disabled:" << ldCache.error().message();
         }
-
-        auto container = this->containerBuilder.create(cfgBuilder);
-        if (!container) {
-            return LINGLONG_ERR(container);
+        auto cached = false;
+        if (ldCache && std::filesystem::exists(*ldCache)) {
+            std::error_code ec;
+            std::filesystem::copy_file(*ldCache,
+                                       appCache / "ld.so.cache",
+                                       std::filesystem::copy_options::overwrite_existing,
+                                       ec);
+            cached = !ec;
         }
 
-        ocppi::runtime::config::types::Process process{ .args = std::vector<std::string>{
-                                                          "/sbin/ldconfig",
-                                                          "-X",
-                                                          "-C",
-                                                          "/run/linglong/cache/ld.so.cache" } };
-        ocppi::runtime::RunOption opt{};
-        auto result = (*container)->run(process, opt);
-        if (!result) {
-            return LINGLONG_ERR("failed to generate ld cache", result);
+        if (!cached) {
+            if (!cfgBuilder.build()) {
+                auto err = cfgBuilder.getError();
+                return LINGLONG_ERR("build cfg error: " + QString::fromStdString(err.reason));
+            }
+
+            auto container = this->containerBuilder.create(cfgBuilder);
+            if (!container) {
+                return LINGLONG_ERR(container);
+            }
+
+            ocppi::runtime::config::types::Process process{
+                .args = std::vector<std::string>{ "/sbin/ldconfig",
+                                                  "-X",
+                                                  "-C",
+                                                  "/run/linglong/cache/ld.so.cache" }
+            };
+            ocppi::runtime::RunOption opt{};
+            auto result = (*container)->run(process, opt);
+            if (!result) {
+                return LINGLONG_ERR("failed to generate ld cache", result);
+            }
+
+            if (ldCache) {
+                storeLDCache(appCache / "ld.so.cache", *ldCache);
+            }
         }
     }
 
@@ -2147,25 +2655,48 @@ utils::error::Result<void> Builder::runFromRepo(const package::Reference &ref,
         // must be closed here, this conf will be used later.
         ldsoconf.close();
 
-        if (!cfgBuilder.build()) {
-            auto err = cfgBuilder.getError();
-            return LINGLONG_ERR("build cfg error: " + QString::fromStdString(err.reason));
+        auto ldCache = ldCacheFile(std::filesystem::path{ this->cfg.repo } / "ld-cache",
+                                   runContext,
+                                   ldRawConf);
+        if (!ldCache) {
+            qWarning() << "ld cache is disabled:" << ldCache.error().message();
         }
-
-        auto container = this->containerBuilder.create(cfgBuilder);
-        if (!container) {
-            return LINGLONG_ERR(container);
+        auto cached = false;
+        if (ldCache && std::filesystem::exists(*ldCache)) {
+            std::error_code ec;
+            std::filesystem::copy_file(*ldCache,
+                                       appCache / "ld.so.cache",
+                                       std::filesystem::copy_options::overwrite_existing,
+                                       ec);
+            cached = !ec;
         }
 
-        ocppi::runtime::config::types::Process process{ .args = std::vector<std::string>{
-                                                          "/sbin/ldconfig",
-                                                          "-X",
-                                                          "-C",
-                                                          "/run/linglong/cache/ld.so.cache" } };
-        ocppi::runtime::RunOption opt{};
-        auto result = (*container)->run(process, opt);
-        if (!result) {
-            return LINGLONG_ERR("failed to generate ld cache", result);
+        if (!cached) {
+            if (!cfgBuilder.build()) {
+                auto err = cfgBuilder.getError();
+                return LINGLONG_ERR("build cfg error: " + QString::fromStdString(err.reason));
+            }
+
+            auto container = this->containerBuilder.create(cfgBuilder);
+            if (!container) {
+                return LINGLONG_ERR(container);
+            }
+
+            ocppi::runtime::config::types::Process process{
+                .args = std::vector<std::string>{ "/sbin/ldconfig",
+                                                  "-X",
+                                                  "-C",
+                                                  "/run/linglong/cache/ld.so.cache" }
+            };
+            ocppi::runtime::RunOption opt{};
+            auto result = (*container)->run(process, opt);
+            if (!result) {
+                return LINGLONG_ERR("failed to generate ld cache", result);
+            }
+
+            if (ldCache) {
+                storeLDCache(appCache / "ld.so.cache", *ldCache);
+            }
         }
     }
 
@@ -2218,9 +2749,61 @@ utils::error::Result<void> Builder::runtimeCheck()
         return LINGLONG_OK;
     }
     printMessage("Start runtime check", 2);
-    // 导出uab时需要使用main-check统计的信息，所以无论是否跳过检查，都需要执行main-check
-    auto ret =
-      this->run(packageModules, { { QString{ LINGLONG_BUILDER_HELPER } + "/main-check.sh" } });
+    auto begin = std::chrono::steady_clock::now();
+
+    // 在宿主机上一次遍历所有模块的输出，并行检查配置文件、desktop文件和ELF文件
+    std::vector<std::filesystem::path> roots;
+    for (const auto &module : std::as_const(packageModules)) {
+        roots.push_back(internalDir / "output" / module.toStdString() / "files");
+    }
+    auto report = OutputChecker(project.package.id).check(roots);
+    if (!report) {
+        return LINGLONG_ERR(report);
+    }
+
+    auto printFiles = [&project](const std::string &title, const std::vector<std::string> &files) {
+        if (files.empty()) {
+            return;
+        }
+        printMessage(title, 2);
+        for (const auto &file : files) {
+            printMessage("/opt/apps/" + project.package.id + "/files" + file, 4);
+        }
+    };
+    printFiles("Warning: these files have invalid file names, we prefer to use "
+                 + project.package.id + " as the prefix:",
+               report->invalidConfigs);
+    printFiles("Warning: these desktop files have no [Desktop Entry] group:",
+               report->invalidEntries);
+    if (!this->buildOptions.skipStripSymbols) {
+        printFiles("Warning: these files are not stripped:", report->unstripped);
+    }
+
+    // 导出uab时需要使用ldd-check统计的信息，所以无论是否跳过检查，都需要执行ldd-check
+    // 依赖需要在运行环境中解析，只检查已找到的可执行文件
+    utils::error::Result<void> ret = LINGLONG_OK;
+    if (report->executables.empty()) {
+        std::ofstream depends(internalDir / "depends.yaml", std::ios::trunc);
+        depends << "# DO NOT EDIT THIS FILE, GENERATED BY ldd-check.sh\n\ndepends: []\n";
+    } else {
+        std::ofstream executables(internalDir / "elf-executables", std::ios::trunc);
+        for (const auto &file : report->executables) {
+            executables << "/opt/apps/" << project.package.id << "/files" << file << '\n';
+        }
+        executables.close();
+        ret = this->run(packageModules,
+                        { QString{ LINGLONG_BUILDER_HELPER } + "/ldd-check.sh",
+                          "--file-list",
+                          "/project/linglong/elf-executables" });
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - begin);
+    printMessage(fmt::format("Checked {} files, {} executables in {} ms",
+                             report->scanned,
+                             report->executables.size(),
+                             elapsed.count()),
+                 2);
     // ignore runtime check if skipCheckOutput is set
     if (this->buildOptions.skipCheckOutput) {
         printMessage("Runtime check ignored", 2);
@@ -2260,6 +2843,9 @@ set -e
         scriptContent.append("export CFLAGS=\"-g $CFLAGS\"\n");
         scriptContent.append("export CXXFLAGS=\"-g $CFLAGS\"\n");
     }
+    if (!this->buildOptions.compilerCache.empty()) {
+        scriptContent.append(compilerCacheScript(this->buildOptions.compilerCache));
+    }
     scriptContent.append(project.build);
     scriptContent.push_back('\n');
     if (!this->buildOptions.skipStripSymbols) {
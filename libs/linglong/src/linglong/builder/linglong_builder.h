@@ -8,6 +8,7 @@
 
 #include "linglong/api/types/v1/BuilderConfig.hpp"
 #include "linglong/api/types/v1/BuilderProject.hpp"
+#include "linglong/builder/install_snapshot.h"
 #include "linglong/oci-cfg-generators/container_cfg_builder.h"
 #include "linglong/repo/ostree_repo.h"
 #include "linglong/runtime/container_builder.h"
@@ -15,7 +16,9 @@
 #include "linglong/utils/error/error.h"
 #include "linglong/utils/overlayfs.h"
 
+#include <atomic>
 #include <filesystem>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -26,6 +29,8 @@ struct ExportOption
     std::string iconPath;
     std::string loader;
     std::string compressor;
+    // mkfs.erofs parameters of the uab bundle, see package::erofsProfile
+    std::string erofsProfile;
     std::string ref;
     std::vector<std::string> modules;
     bool noExportDevelop{ false };
@@ -43,6 +48,12 @@ struct BuilderBuildOptions
     bool skipCheckOutput{ false };
     bool skipStripSymbols{ false };
     bool isolateNetWork{ false };
+    // compiler cache used in build stage, "ccache" or "sccache", empty means disabled
+    std::string compilerCache;
+    // share the compiler cache between projects using the same base and runtime
+    bool sharedCompilerCache{ false };
+    // keep the build output between builds, only install the files changed since last commit
+    bool incremental{ false };
 };
 
 utils::error::Result<void> cmdListApp(repo::OSTreeRepo &repo);
@@ -95,15 +106,21 @@ public:
 
 private:
     auto buildStagePrepare() noexcept -> utils::error::Result<void>;
-    auto buildStageFetchSource() noexcept -> utils::error::Result<void>;
-    utils::error::Result<void> buildStagePullDependency() noexcept;
+    auto buildStageFetchSource(const std::atomic_bool *cancelled = nullptr) noexcept
+      -> utils::error::Result<void>;
+    utils::error::Result<void>
+    buildStagePullDependency(GCancellable *cancellable = nullptr) noexcept;
     utils::error::Result<bool> buildStageBuild(const QStringList &args) noexcept;
     utils::error::Result<void> buildStagePreBuild() noexcept;
+    utils::error::Result<std::filesystem::path> compilerCacheDir() noexcept;
     utils::error::Result<void> buildStagePreCommit() noexcept;
     utils::error::Result<bool> buildStageCommit() noexcept;
 
+    utils::error::Result<void> checkCommitSpace() noexcept;
     utils::error::Result<void> generateAppConf() noexcept;
     utils::error::Result<void> installFiles() noexcept;
+    utils::error::Result<std::vector<std::string>> prepareIncrementalInstall(
+      const std::vector<api::types::v1::BuilderProjectModules> &modules) noexcept;
     utils::error::Result<void> generateEntries() noexcept;
     utils::error::Result<void> processBuildDepends() noexcept;
     utils::error::Result<void> commitToLocalRepo() noexcept;
@@ -143,6 +160,8 @@ private:
     QDir buildOutput;
     std::string installPrefix;
     runtime::RunContext buildContext;
+    // snapshot of the build output taken by incremental install, saved after commit
+    std::optional<InstallSnapshot> installSnapshot;
 
     // capabilities for build stage
     static std::vector<std::string> privilegeBuilderCaps;
@@ -0,0 +1,301 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "output_checker.h"
+
+#include "linglong/utils/log/log.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <set>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace linglong::builder {
+
+namespace {
+
+struct ElfInfo
+{
+    bool unstripped{ false };
+    bool executable{ false };
+};
+
+bool inRange(std::size_t size, std::size_t offset, std::size_t length) noexcept
+{
+    return offset <= size && length <= size - offset;
+}
+
+// the section headers are used instead of nm, a symbol table means the file is not stripped
+// and __libc_start_main in the dynamic symbols means the file is an executable
+template <typename Ehdr, typename Shdr, typename Sym>
+std::optional<ElfInfo> inspectElf(const unsigned char *data, std::size_t size) noexcept
+{
+    if (size < sizeof(Ehdr)) {
+        return std::nullopt;
+    }
+
+    Ehdr ehdr{};
+    std::memcpy(&ehdr, data, sizeof(ehdr));
+    if (ehdr.e_shoff == 0 || ehdr.e_shentsize != sizeof(Shdr)
+        || !inRange(size, ehdr.e_shoff, std::size_t{ ehdr.e_shnum } * sizeof(Shdr))) {
+        return std::nullopt;
+    }
+
+    auto section = [data, &ehdr](std::size_t index) {
+        Shdr shdr{};
+        std::memcpy(&shdr, data + ehdr.e_shoff + index * sizeof(Shdr), sizeof(shdr));
+        return shdr;
+    };
+
+    ElfInfo info;
+    for (std::size_t i = 0; i < ehdr.e_shnum; ++i) {
+        auto shdr = section(i);
+        if (shdr.sh_type == SHT_SYMTAB) {
+            info.unstripped = true;
+        }
+        if (shdr.sh_type != SHT_DYNSYM || shdr.sh_link >= ehdr.e_shnum || info.executable) {
+            continue;
+        }
+
+        auto strtab = section(shdr.sh_link);
+        if (!inRange(size, shdr.sh_offset, shdr.sh_size)
+            || !inRange(size, strtab.sh_offset, strtab.sh_size)) {
+            continue;
+        }
+
+        const auto *names = reinterpret_cast<const char *>(data + strtab.sh_offset);
+        for (std::size_t offset = 0; offset + sizeof(Sym) <= shdr.sh_size; offset += sizeof(Sym)) {
+            Sym sym{};
+            std::memcpy(&sym, data + shdr.sh_offset + offset, sizeof(sym));
+            if (sym.st_name >= strtab.sh_size) {
+                continue;
+            }
+
+            std::string_view name(names + sym.st_name,
+                                  ::strnlen(names + sym.st_name, strtab.sh_size - sym.st_name));
+            if (name == "__libc_start_main") {
+                info.executable = true;
+                break;
+            }
+        }
+    }
+
+    return info;
+}
+
+std::optional<ElfInfo> inspectFile(const std::filesystem::path &file) noexcept
+{
+    auto fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return std::nullopt;
+    }
+
+    std::optional<ElfInfo> info;
+    std::array<unsigned char, EI_NIDENT> ident{};
+    struct stat st{};
+    // read the magic number first, most of the files aren't ELF files
+    if (::read(fd, ident.data(), ident.size()) == static_cast<ssize_t>(ident.size())
+        && std::memcmp(ident.data(), ELFMAG, SELFMAG) == 0 && ::fstat(fd, &st) == 0) {
+        auto size = static_cast<std::size_t>(st.st_size);
+        auto *data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            const auto *bytes = static_cast<const unsigned char *>(data);
+            if (ident[EI_CLASS] == ELFCLASS64) {
+                info = inspectElf<Elf64_Ehdr, Elf64_Shdr, Elf64_Sym>(bytes, size);
+            } else if (ident[EI_CLASS] == ELFCLASS32) {
+                info = inspectElf<Elf32_Ehdr, Elf32_Shdr, Elf32_Sym>(bytes, size);
+            }
+            ::munmap(data, size);
+        }
+    }
+
+    ::close(fd);
+    return info;
+}
+
+bool hasDesktopEntryGroup(const std::filesystem::path &file) noexcept
+{
+    std::ifstream stream(file);
+    std::string line;
+    while (std::getline(stream, line)) {
+        line.erase(0, line.find_first_not_of(" \t"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line == "[Desktop Entry]") {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool hasPrefix(std::string_view str, std::string_view prefix) noexcept
+{
+    return str.substr(0, prefix.size()) == prefix;
+}
+
+bool hasSuffix(std::string_view str, std::string_view suffix) noexcept
+{
+    return str.size() >= suffix.size() && str.substr(str.size() - suffix.size()) == suffix;
+}
+
+} // namespace
+
+OutputChecker::OutputChecker(std::string appId) noexcept
+    : appId(std::move(appId))
+{
+}
+
+bool OutputChecker::isConfigFile(const std::string &path) const noexcept
+{
+    constexpr std::array systemdUnits{ ".service", ".socket", ".device", ".mount",
+                                       ".automount", ".swap", ".target", ".path",
+                                       ".timer", ".slice", ".scope" };
+
+    if (hasPrefix(path, "/share/applications/context-menus/")) {
+        return hasSuffix(path, ".conf");
+    }
+    if (hasPrefix(path, "/share/applications/")) {
+        return hasSuffix(path, ".desktop");
+    }
+    if (hasPrefix(path, "/share/dbus-1/services/")) {
+        return hasSuffix(path, ".service");
+    }
+    if (hasPrefix(path, "/lib/systemd/user/")) {
+        return std::any_of(systemdUnits.begin(), systemdUnits.end(), [&path](const char *unit) {
+            return hasSuffix(path, unit);
+        });
+    }
+
+    return false;
+}
+
+void OutputChecker::checkFile(const std::filesystem::path &file,
+                              const std::string &path,
+                              OutputCheckReport &report) const noexcept
+{
+    if (this->isConfigFile(path)) {
+        auto name = std::filesystem::path(path).filename().string();
+        if (!hasPrefix(name, this->appId)) {
+            report.invalidConfigs.push_back(path);
+        }
+        if (hasSuffix(path, ".desktop") && !hasDesktopEntryGroup(file)) {
+            report.invalidEntries.push_back(path);
+        }
+    }
+
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(std::filesystem::symlink_status(file, ec))) {
+        return;
+    }
+
+    auto info = inspectFile(file);
+    if (!info) {
+        return;
+    }
+    if (info->unstripped && !hasSuffix(path, ".debug")) {
+        report.unstripped.push_back(path);
+    }
+    if (info->executable) {
+        report.executables.push_back(path);
+    }
+}
+
+utils::error::Result<OutputCheckReport>
+OutputChecker::check(const std::vector<std::filesystem::path> &roots,
+                     unsigned int jobs) const noexcept
+{
+    LINGLONG_TRACE("check output");
+
+    // a file is checked once even if it exists in several modules
+    std::set<std::string> seen;
+    std::vector<std::pair<std::filesystem::path, std::string>> files;
+    for (const auto &root : roots) {
+        std::error_code ec;
+        if (!std::filesystem::exists(root, ec)) {
+            continue;
+        }
+
+        for (auto iter = std::filesystem::recursive_directory_iterator(root, ec);
+             iter != std::filesystem::recursive_directory_iterator();
+             iter.increment(ec)) {
+            if (ec) {
+                break;
+            }
+            if (iter->is_directory(ec) && !iter->is_symlink(ec)) {
+                continue;
+            }
+
+            auto path = "/" + iter->path().lexically_relative(root).string();
+            if (seen.insert(path).second) {
+                files.emplace_back(iter->path(), std::move(path));
+            }
+        }
+        if (ec) {
+            return LINGLONG_ERR(
+              fmt::format("failed to iterate {}: {}", root, ec.message()).c_str());
+        }
+    }
+
+    if (jobs == 0) {
+        jobs = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    jobs = static_cast<unsigned int>(
+      std::min<std::size_t>(jobs, std::max<std::size_t>(files.size(), 1)));
+
+    std::vector<OutputCheckReport> reports(jobs);
+    std::atomic_size_t next{ 0 };
+    auto worker = [this, &files, &next](OutputCheckReport &report) {
+        for (auto i = next++; i < files.size(); i = next++) {
+            this->checkFile(files[i].first, files[i].second, report);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(jobs - 1);
+    for (unsigned int i = 1; i < jobs; ++i) {
+        threads.emplace_back(worker, std::ref(reports[i]));
+    }
+    worker(reports[0]);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    OutputCheckReport report;
+    report.scanned = files.size();
+    for (auto &part : reports) {
+        for (auto [to, from] : { std::pair{ &report.invalidConfigs, &part.invalidConfigs },
+                                 std::pair{ &report.invalidEntries, &part.invalidEntries },
+                                 std::pair{ &report.unstripped, &part.unstripped },
+                                 std::pair{ &report.executables, &part.executables } }) {
+            to->insert(to->end(),
+                       std::make_move_iterator(from->begin()),
+                       std::make_move_iterator(from->end()));
+        }
+    }
+    for (auto *paths : { &report.invalidConfigs,
+                         &report.invalidEntries,
+                         &report.unstripped,
+                         &report.executables }) {
+        std::sort(paths->begin(), paths->end());
+    }
+
+    return report;
+}
+
+} // namespace linglong::builder
@@ -0,0 +1,54 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "linglong/utils/error/error.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace linglong::builder {
+
+struct OutputCheckReport
+{
+    std::size_t scanned{ 0 };
+    // config files (desktop, context menu, dbus service, systemd user unit) whose name
+    // doesn't start with the app id
+    std::vector<std::string> invalidConfigs;
+    // desktop files without a [Desktop Entry] group
+    std::vector<std::string> invalidEntries;
+    // ELF files which still have a symbol table
+    std::vector<std::string> unstripped;
+    // dynamically linked ELF files calling __libc_start_main, their dependencies are
+    // resolved by ldd in the runtime container
+    std::vector<std::string> executables;
+};
+
+// OutputChecker walks the output of the app modules once and checks every file in parallel,
+// it replaces the find based walks of main-check.sh. The reported paths are relative to the
+// files directory of the app, e.g. "/bin/demo".
+class OutputChecker
+{
+public:
+    explicit OutputChecker(std::string appId) noexcept;
+
+    // roots are the files directories of the modules, jobs is 0 to use all cpus
+    [[nodiscard]] utils::error::Result<OutputCheckReport>
+    check(const std::vector<std::filesystem::path> &roots, unsigned int jobs = 0) const noexcept;
+
+private:
+    void checkFile(const std::filesystem::path &file,
+                   const std::string &path,
+                   OutputCheckReport &report) const noexcept;
+    [[nodiscard]] bool isConfigFile(const std::string &path) const noexcept;
+
+    std::string appId;
+};
+
+} // namespace linglong::builder
@@ -6,26 +6,57 @@
 #pragma once
 
 #include <iostream>
+#include <mutex>
 #include <string>
 
 namespace linglong::builder {
 
+namespace detail {
+
+// stages of the builder may print at the same time, e.g. fetching sources and pulling
+// dependencies, the line being replaced is kept so other messages are printed above it
+struct PrinterState
+{
+    std::mutex mutex;
+    std::string replacedLine;
+};
+
+inline PrinterState &printerState()
+{
+    static PrinterState state;
+    return state;
+}
+
+} // namespace detail
+
 inline void printMessage(const std::string &text, const size_t num = 0)
 {
     std::string blank(num, ' ');
 
-    std::cout << blank << text << std::endl;
+    auto &state = detail::printerState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.replacedLine.empty()) {
+        std::cout << blank << text << std::endl;
+        return;
+    }
+
+    std::cout << "\33[2K\r" << blank << text << std::endl << state.replacedLine << std::flush;
 }
 
 inline void printReplacedText(const std::string &text, const size_t num = 0)
 {
     std::string blank(num, ' ');
 
+    auto &state = detail::printerState();
+    std::lock_guard<std::mutex> lock(state.mutex);
     std::cout << "\33[2K\r" << blank << text << std::flush;
+    // a line ending with newline is finished
+    state.replacedLine = !text.empty() && text.back() == '\n' ? std::string{} : blank + text;
 }
 
 inline void printProgress(const size_t num = 0)
 {
+    std::lock_guard<std::mutex> lock(detail::printerState().mutex);
     std::cout << "\33[2K\r"
               << "[";
     for (size_t i = 0; i < num; ++i) {
@@ -54,6 +54,9 @@ auto SourceFetcher::fetch(QDir destination) noexcept -> utils::error::Result<voi
         qDebug() << "Dumping " << scriptName << "from qrc to" << scriptFile;
         QFile::copy(":/scripts/" + scriptName, scriptFile);
     }
+    if (!this->gitMirrorDir.isEmpty()) {
+        m_cmd->setEnv("LINGLONG_GIT_MIRROR_DIR", this->gitMirrorDir);
+    }
     auto output =
       m_cmd->setEnv("GIT_SUBMODULES", source.submodules.value_or(true) ? "true" : "")
         .exec({
@@ -27,9 +27,14 @@ public:
 
     void setCommand(std::shared_ptr<utils::command::Cmd> cmd) { this->m_cmd = cmd; }
 
+    // git sources are fetched through bare mirrors in this directory, it can be shared
+    // between projects. If it's not set, mirrors are kept in the cache directory.
+    void setGitMirrorDir(const QDir &dir) { this->gitMirrorDir = dir.absolutePath(); }
+
 private:
     QString getSourceName();
     QDir cacheDir;
+    QString gitMirrorDir;
     api::types::v1::BuilderProjectSource source;
     std::shared_ptr<utils::command::Cmd> m_cmd = std::make_shared<utils::command::Cmd>("sh");
 };
@@ -40,6 +40,7 @@
 #include "linglong/utils/gettext.h"
 #include "linglong/utils/log/log.h"
 #include "linglong/utils/serialize/json.h"
+#include "linglong/utils/trace/span.h"
 #include "linglong/utils/xdg/directory.h"
 #include "ocppi/runtime/ExecOption.hpp"
 #include "ocppi/runtime/RunOption.hpp"
@@ -458,7 +459,7 @@ void Cli::interaction(QDBusObjectPath object_path, int messageID, QVariantMap ad
     auto reply = api::types::v1::InteractionReply{ .action = action };
 
     QDBusPendingReply<void> dbusReply =
-      this->pkgMan.ReplyInteraction(object_path, utils::serialize::toQVariantMap(reply));
+      this->pkgMan->ReplyInteraction(object_path, utils::serialize::toQVariantMap(reply));
     dbusReply.waitForFinished();
     if (dbusReply.isError()) {
         if (dbusReply.error().type() == QDBusError::AccessDenied) {
@@ -574,7 +575,7 @@ void Cli::printProgress() noexcept
 Cli::Cli(Printer &printer,
          ocppi::cli::CLI &ociCLI,
          runtime::ContainerBuilder &containerBuilder,
-         api::dbus::v1::PackageManager &pkgMan,
+         PackageManagerFactory pkgManFactory,
          repo::OSTreeRepo &repo,
          std::unique_ptr<InteractiveNotifier> &&notifier,
          QObject *parent)
@@ -584,31 +585,49 @@ Cli::Cli(Printer &printer,
     , containerBuilder(containerBuilder)
     , repository(repo)
     , notifier(std::move(notifier))
-    , pkgMan(pkgMan)
+    , pkgManFactory(std::move(pkgManFactory))
 {
-    auto conn = pkgMan.connection();
-    if (!conn.connect(pkgMan.service(),
-                      pkgMan.path(),
-                      pkgMan.interface(),
+}
+
+utils::error::Result<void> Cli::ensurePackageManager() noexcept
+{
+    LINGLONG_TRACE("connect to package manager");
+
+    if (this->pkgMan != nullptr) {
+        return LINGLONG_OK;
+    }
+
+    auto proxy = this->pkgManFactory();
+    if (!proxy) {
+        return LINGLONG_ERR(proxy);
+    }
+
+    auto conn = (*proxy)->connection();
+    if (!conn.connect((*proxy)->service(),
+                      (*proxy)->path(),
+                      (*proxy)->interface(),
                       "TaskAdd",
                       this,
                       SLOT(onTaskAdded(QDBusObjectPath)))) {
-        qFatal("couldn't connect to package manager signal 'TaskAdded'");
+        return LINGLONG_ERR("couldn't connect to package manager signal 'TaskAdded'");
     }
 
-    if (!conn.connect(pkgMan.service(),
-                      pkgMan.path(),
-                      pkgMan.interface(),
+    if (!conn.connect((*proxy)->service(),
+                      (*proxy)->path(),
+                      (*proxy)->interface(),
                       "TaskRemoved",
                       this,
                       SLOT(onTaskRemoved(QDBusObjectPath, int, int, QString, double, int)))) {
-        qFatal("couldn't connect to package manager signal 'TaskRemoved'");
+        return LINGLONG_ERR("couldn't connect to package manager signal 'TaskRemoved'");
     }
+
+    this->pkgMan = *proxy;
+    return LINGLONG_OK;
 }
 
 int Cli::run(const RunOptions &options)
 {
-    LINGLONG_TRACE("command run");
+    LINGLONG_TRACE_SPAN("command run");
 
     auto uid = getuid();
     auto gid = getgid();
@@ -812,11 +831,20 @@ int Cli::run(const RunOptions &options)
     }
     cfgBuilder.setAppCache(*appCache).enableLDCache();
 
+    if (utils::trace::enabled()) {
+        // ll-init records the time it takes to exec the application into the same file
+        cfgBuilder.appendEnv("LINGLONG_TRACE_FILE",
+                             "/run/host/rootfs" + utils::trace::traceFile(),
+                             true);
+    }
+
+    utils::trace::Span buildSpan{ "build container config" };
     if (!cfgBuilder.build()) {
         auto err = cfgBuilder.getError();
         qCritical() << "build cfg error: " << QString::fromStdString(err.reason);
         return -1;
     }
+    buildSpan.end();
 
     auto container = this->containerBuilder.create(cfgBuilder);
     if (!container) {
@@ -1062,10 +1090,10 @@ int Cli::installFromFile(const QFileInfo &fileInfo,
         return -1;
     }
 
-    auto conn = this->pkgMan.connection();
-    auto con = conn.connect(this->pkgMan.service(),
-                            this->pkgMan.path(),
-                            this->pkgMan.interface(),
+    auto conn = this->pkgMan->connection();
+    auto con = conn.connect(this->pkgMan->service(),
+                            this->pkgMan->path(),
+                            this->pkgMan->interface(),
                             "RequestInteraction",
                             this,
                             SLOT(interaction(QDBusObjectPath, int, QVariantMap)));
@@ -1077,7 +1105,7 @@ int Cli::installFromFile(const QFileInfo &fileInfo,
     QDBusUnixFileDescriptor dbusFileDescriptor(file.handle());
 
     auto pendingReply =
-      this->pkgMan.InstallFromFile(dbusFileDescriptor,
+      this->pkgMan->InstallFromFile(dbusFileDescriptor,
                                    fileInfo.suffix(),
                                    utils::serialize::toQVariantMap(commonOptions));
     pendingReply.waitForFinished();
@@ -1108,10 +1136,10 @@ int Cli::installFromFile(const QFileInfo &fileInfo,
     }
 
     this->taskObjectPath = QString::fromStdString(result->taskObjectPath.value());
-    task = new api::dbus::v1::Task1(pkgMan.service(), taskObjectPath, conn);
+    task = new api::dbus::v1::Task1(pkgMan->service(), taskObjectPath, conn);
     this->lastState = linglong::api::types::v1::State::Queued;
 
-    if (!conn.connect(pkgMan.service(),
+    if (!conn.connect(pkgMan->service(),
                       taskObjectPath,
                       "org.freedesktop.DBus.Properties",
                       "PropertiesChanged",
@@ -1141,6 +1169,11 @@ int Cli::install(const InstallOptions &options)
 {
     LINGLONG_TRACE("command install");
 
+    if (auto ret = this->ensurePackageManager(); !ret) {
+        this->printer.printErr(ret.error());
+        return -1;
+    }
+
     auto params =
       api::types::v1::PackageManager1InstallParameters{ .options = { .force = false,
                                                                      .skipInteraction = false } };
@@ -1165,10 +1198,10 @@ int Cli::install(const InstallOptions &options)
         return -1;
     }
 
-    auto conn = this->pkgMan.connection();
-    auto con = conn.connect(this->pkgMan.service(),
-                            this->pkgMan.path(),
-                            this->pkgMan.interface(),
+    auto conn = this->pkgMan->connection();
+    auto con = conn.connect(this->pkgMan->service(),
+                            this->pkgMan->path(),
+                            this->pkgMan->interface(),
                             "RequestInteraction",
                             this,
                             SLOT(interaction(QDBusObjectPath, int, QVariantMap)));
@@ -1202,7 +1235,7 @@ int Cli::install(const InstallOptions &options)
         qDebug() << module.c_str();
     }
 
-    auto pendingReply = this->pkgMan.Install(utils::serialize::toQVariantMap(params));
+    auto pendingReply = this->pkgMan->Install(utils::serialize::toQVariantMap(params));
     pendingReply.waitForFinished();
 
     if (pendingReply.isError()) {
@@ -1272,10 +1305,10 @@ int Cli::install(const InstallOptions &options)
     }
 
     this->taskObjectPath = QString::fromStdString(result->taskObjectPath.value());
-    task = new api::dbus::v1::Task1(pkgMan.service(), taskObjectPath, conn);
+    task = new api::dbus::v1::Task1(pkgMan->service(), taskObjectPath, conn);
     this->lastState = linglong::api::types::v1::State::Queued;
 
-    if (!conn.connect(pkgMan.service(),
+    if (!conn.connect(pkgMan->service(),
                       taskObjectPath,
                       "org.freedesktop.DBus.Properties",
                       "PropertiesChanged",
@@ -1301,6 +1334,11 @@ int Cli::upgrade(const UpgradeOptions &options)
 {
     LINGLONG_TRACE("command upgrade");
 
+    if (auto ret = this->ensurePackageManager(); !ret) {
+        this->printer.printErr(ret.error());
+        return -1;
+    }
+
     QDBusReply<QString> authReply = this->authorization();
     if (!authReply.isValid() && authReply.error().type() == QDBusError::AccessDenied) {
         auto ret = this->runningAsRoot();
@@ -1376,7 +1414,7 @@ int Cli::upgrade(const UpgradeOptions &options)
         params.packages.emplace_back(std::move(package));
     }
 
-    auto pendingReply = this->pkgMan.Update(utils::serialize::toQVariantMap(params));
+    auto pendingReply = this->pkgMan->Update(utils::serialize::toQVariantMap(params));
     pendingReply.waitForFinished();
 
     if (pendingReply.isError()) {
@@ -1406,11 +1444,11 @@ int Cli::upgrade(const UpgradeOptions &options)
     }
 
     this->taskObjectPath = QString::fromStdString(result->taskObjectPath.value());
-    auto conn = pkgMan.connection();
-    task = new api::dbus::v1::Task1(pkgMan.service(), taskObjectPath, conn);
+    auto conn = pkgMan->connection();
+    task = new api::dbus::v1::Task1(pkgMan->service(), taskObjectPath, conn);
     this->lastState = linglong::api::types::v1::State::Queued;
 
-    if (!conn.connect(pkgMan.service(),
+    if (!conn.connect(pkgMan->service(),
                       taskObjectPath,
                       "org.freedesktop.DBus.Properties",
                       "PropertiesChanged",
@@ -1440,10 +1478,24 @@ int Cli::search(const SearchOptions &options)
 {
     LINGLONG_TRACE("command search");
 
+    if (auto ret = this->ensurePackageManager(); !ret) {
+        this->printer.printErr(ret.error());
+        return -1;
+    }
+
+    // let package manager drop the records which will not be displayed
     auto params = api::types::v1::PackageManager1SearchParameters{
         .id = options.appid,
+        .latestOnly = !options.showAllVersion,
+        .refresh = options.refresh,
         .repos = {},
     };
+    if (!options.showDevel) {
+        params.excludeModules = std::vector<std::string>{ "develop" };
+    }
+    if (!options.type.empty()) {
+        params.kind = options.type;
+    }
 
     auto repoConfig = this->repository.getOrderedConfig();
 
@@ -1473,7 +1525,7 @@ int Cli::search(const SearchOptions &options)
 
     std::optional<QString> pendingJobID;
 
-    auto pendingReply = this->pkgMan.Search(utils::serialize::toQVariantMap(params));
+    auto pendingReply = this->pkgMan->Search(utils::serialize::toQVariantMap(params));
 
     pendingReply.waitForFinished();
     if (pendingReply.isError()) {
@@ -1499,7 +1551,7 @@ int Cli::search(const SearchOptions &options)
 
     QEventLoop loop;
     connect(
-      &this->pkgMan,
+      this->pkgMan,
       &api::dbus::v1::PackageManager::SearchFinished,
       [&pendingJobID, this, &loop, &options](const QString &jobID, const QVariantMap &data) {
           LINGLONG_TRACE("process search result");
@@ -1545,6 +1597,8 @@ int Cli::search(const SearchOptions &options)
               return;
           }
 
+          // NOTE: a package manager of older version ignores the filters in search parameters,
+          // so the result is still filtered here.
           auto allPackages = std::move(result->packages).value();
           if (!options.showDevel) {
               std::for_each(allPackages.begin(),
@@ -1580,6 +1634,11 @@ int Cli::prune()
 {
     LINGLONG_TRACE("command prune");
 
+    if (auto ret = this->ensurePackageManager(); !ret) {
+        this->printer.printErr(ret.error());
+        return -1;
+    }
+
     QDBusReply<QString> authReply = this->authorization();
     if (!authReply.isValid() && authReply.error().type() == QDBusError::AccessDenied) {
         auto ret = this->runningAsRoot();
@@ -1592,7 +1651,7 @@ int Cli::prune()
     QEventLoop loop;
     QString jobIDReply = "";
     auto ret = connect(
-      &this->pkgMan,
+      this->pkgMan,
       &api::dbus::v1::PackageManager::PruneFinished,
       [this, &loop, &jobIDReply](const QString &jobID, const QVariantMap &data) {
           LINGLONG_TRACE("process prune result");
@@ -1617,7 +1676,7 @@ int Cli::prune()
           loop.exit(0);
       });
 
-    auto pendingReply = this->pkgMan.Prune();
+    auto pendingReply = this->pkgMan->Prune();
     pendingReply.waitForFinished();
 
     if (pendingReply.isError()) {
@@ -1648,6 +1707,11 @@ int Cli::uninstall(const UninstallOptions &options)
 {
     LINGLONG_TRACE("command uninstall");
 
+    if (auto ret = this->ensurePackageManager(); !ret) {
+        this->printer.printErr(ret.error());
+        return -1;
+    }
+
     QDBusReply<QString> authReply = this->authorization();
     if (!authReply.isValid() && authReply.error().type() == QDBusError::AccessDenied) {
         auto ret = this->runningAsRoot();
@@ -1675,7 +1739,7 @@ int Cli::uninstall(const UninstallOptions &options)
         params.package.packageManager1PackageModule = options.module;
     }
 
-    auto pendingReply = this->pkgMan.Uninstall(utils::serialize::toQVariantMap(params));
+    auto pendingReply = this->pkgMan->Uninstall(utils::serialize::toQVariantMap(params));
     pendingReply.waitForFinished();
 
     if (pendingReply.isError()) {
@@ -1744,11 +1808,11 @@ int Cli::uninstall(const UninstallOptions &options)
     }
 
     this->taskObjectPath = QString::fromStdString(result->taskObjectPath.value());
-    auto conn = pkgMan.connection();
-    task = new api::dbus::v1::Task1(pkgMan.service(), taskObjectPath, conn);
+    auto conn = pkgMan->connection();
+    task = new api::dbus::v1::Task1(pkgMan->service(), taskObjectPath, conn);
     this->lastState = linglong::api::types::v1::State::Queued;
 
-    if (!conn.connect(pkgMan.service(),
+    if (!conn.connect(pkgMan->service(),
                       taskObjectPath,
                       "org.freedesktop.DBus.Properties",
                       "PropertiesChanged",
@@ -1790,24 +1854,25 @@ int Cli::list(const ListOptions &options)
         this->printer.printErr(items.error());
         return -1;
     }
-    std::vector<api::types::v1::PackageInfoDisplay> list;
+    // 按id排序, sort the cache items first so that packages can be printed as soon as converted
+    std::stable_sort(items->begin(), items->end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.info.id < rhs.info.id;
+    });
+    this->printer.beginPackages();
     for (const auto &item : *items) {
+        if (!options.type.empty() && options.type != "all" && item.info.kind != options.type) {
+            continue;
+        }
+
         nlohmann::json json = item.info;
         auto m = json.get<api::types::v1::PackageInfoDisplay>();
         auto t = this->repository.getLayerCreateTime(item);
         if (t.has_value()) {
             m.installTime = *t;
         }
-        list.push_back(std::move(m));
-    }
-    if (!options.type.empty()) {
-        filterPackageInfosByType(list, options.type);
+        this->printer.printPackageEntry(m);
     }
-    // 按id排序
-    std::sort(list.begin(), list.end(), [](const auto &lhs, const auto &rhs) {
-        return lhs.id < rhs.id;
-    });
-    this->printer.printPackages(list);
+    this->printer.endPackages();
     return 0;
 }
 
@@ -1890,16 +1955,21 @@ int Cli::repo(CLI::App *app, const RepoOptions &options)
 {
     LINGLONG_TRACE("command repo");
 
-    auto propCfg = this->pkgMan.configuration();
+    if (auto ret = this->ensurePackageManager(); !ret) {
+        this->printer.printErr(ret.error());
+        return -1;
+    }
+
+    auto propCfg = this->pkgMan->configuration();
     // check error here, this operation could be failed
-    if (this->pkgMan.lastError().isValid()) {
-        if (this->pkgMan.lastError().type() == QDBusError::AccessDenied) {
+    if (this->pkgMan->lastError().isValid()) {
+        if (this->pkgMan->lastError().type() == QDBusError::AccessDenied) {
             this->notifier->notify(
               api::types::v1::InteractionRequest{ .summary = permissionNotifyMsg });
             return -1;
         }
 
-        auto err = LINGLONG_ERRV(this->pkgMan.lastError().message());
+        auto err = LINGLONG_ERRV(this->pkgMan->lastError().message());
         this->printer.printErr(err);
         return -1;
     }
@@ -2054,6 +2124,11 @@ int Cli::setRepoConfig(const QVariantMap &config)
 {
     LINGLONG_TRACE("set repo config");
 
+    if (auto ret = this->ensurePackageManager(); !ret) {
+        this->printer.printErr(ret.error());
+        return -1;
+    }
+
     QDBusReply<QString> authReply = this->authorization();
     if (!authReply.isValid() && authReply.error().type() == QDBusError::AccessDenied) {
         auto ret = this->runningAsRoot();
@@ -2063,15 +2138,15 @@ int Cli::setRepoConfig(const QVariantMap &config)
         return -1;
     }
 
-    this->pkgMan.setConfiguration(config);
-    if (this->pkgMan.lastError().isValid()) {
-        if (this->pkgMan.lastError().type() == QDBusError::AccessDenied) {
+    this->pkgMan->setConfiguration(config);
+    if (this->pkgMan->lastError().isValid()) {
+        if (this->pkgMan->lastError().type() == QDBusError::AccessDenied) {
             this->notifier->notify(
               api::types::v1::InteractionRequest{ .summary = permissionNotifyMsg });
             return -1;
         }
 
-        auto err = LINGLONG_ERRV(this->pkgMan.lastError().message());
+        auto err = LINGLONG_ERRV(this->pkgMan->lastError().message());
         this->printer.printErr(err);
         return -1;
     }
@@ -2344,20 +2419,6 @@ void Cli::filterPackageInfosByType(
     list = std::move(filtered);
 }
 
-void Cli::filterPackageInfosByType(std::vector<api::types::v1::PackageInfoDisplay> &list,
-                                   const std::string &type)
-{
-    if (type == "all") {
-        return;
-    }
-    list.erase(std::remove_if(list.begin(),
-                              list.end(),
-                              [&type](const api::types::v1::PackageInfoDisplay &pkg) {
-                                  return pkg.kind != type;
-                              }),
-               list.end());
-}
-
 utils::error::Result<void> Cli::filterPackageInfosByVersion(
   std::map<std::string, std::vector<api::types::v1::PackageInfoV2>> &list) noexcept
 {
@@ -2448,10 +2509,10 @@ QDBusReply<QString> Cli::authorization()
 {
     // Note: we have marked the method Permissions of PM as rejected.
     // Use this method to determin that this client whether have permission to call PM.
-    QDBusInterface dbusIntrospect(this->pkgMan.service(),
-                                  this->pkgMan.path(),
-                                  this->pkgMan.service(),
-                                  this->pkgMan.connection());
+    QDBusInterface dbusIntrospect(this->pkgMan->service(),
+                                  this->pkgMan->path(),
+                                  this->pkgMan->service(),
+                                  this->pkgMan->connection());
     return dbusIntrospect.call("Permissions");
 }
 
@@ -2649,9 +2710,14 @@ Cli::RequestDirectories(const api::types::v1::PackageInfoV2 &info) noexcept
 int Cli::generateCache(const package::Reference &ref)
 {
     LINGLONG_TRACE("generate cache for " + ref.toString());
+
+    if (auto ret = this->ensurePackageManager(); !ret) {
+        this->printer.printErr(ret.error());
+        return -1;
+    }
     QEventLoop loop;
     QString jobIDReply;
-    auto ret = connect(&this->pkgMan,
+    auto ret = connect(this->pkgMan,
                        &api::dbus::v1::PackageManager::GenerateCacheFinished,
                        [&loop, &jobIDReply](const QString &jobID, bool success) {
                            if (jobIDReply != jobID) {
@@ -2664,7 +2730,7 @@ int Cli::generateCache(const package::Reference &ref)
                            loop.exit(0);
                        });
 
-    auto pendingReply = this->pkgMan.GenerateCache(ref.toString());
+    auto pendingReply = this->pkgMan->GenerateCache(ref.toString());
     pendingReply.waitForFinished();
     if (pendingReply.isError()) {
         auto err = LINGLONG_ERRV(pendingReply.error().message());
@@ -2686,7 +2752,7 @@ int Cli::generateCache(const package::Reference &ref)
 utils::error::Result<std::filesystem::path> Cli::ensureCache(
   runtime::RunContext &runContext, const generator::ContainerCfgBuilder &cfgBuilder) noexcept
 {
-    LINGLONG_TRACE("ensure cache");
+    LINGLONG_TRACE_SPAN("ensure cache");
 
     auto appLayerItem = runContext.getCachedAppItem();
     if (!appLayerItem) {
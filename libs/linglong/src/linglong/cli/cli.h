@@ -19,6 +19,8 @@
 
 #include <CLI/CLI.hpp>
 
+#include <functional>
+
 namespace linglong::runtime {
 class RunContext;
 }
@@ -31,6 +33,11 @@ namespace linglong::cli {
 
 class Printer;
 
+// Creates the package manager proxy on first use, so that subcommands which only read local state
+// never touch the package manager daemon.
+using PackageManagerFactory =
+  std::function<utils::error::Result<api::dbus::v1::PackageManager *>()>;
+
 // 全局选项（仅用于verbose等通用选项）
 struct GlobalOptions
 {
@@ -83,6 +90,7 @@ struct SearchOptions
     std::optional<std::string> repo;
     bool showDevel{ false };
     bool showAllVersion{ false };
+    bool refresh{ false };
 };
 
 struct UninstallOptions
@@ -138,7 +146,7 @@ public:
     Cli(Printer &printer,
         ocppi::cli::CLI &ociCLI,
         runtime::ContainerBuilder &containerBuilder,
-        api::dbus::v1::PackageManager &pkgMan,
+        PackageManagerFactory pkgManFactory,
         repo::OSTreeRepo &repo,
         std::unique_ptr<InteractiveNotifier> &&notifier,
         QObject *parent = nullptr);
@@ -174,8 +182,6 @@ private:
     static void filterPackageInfosByType(
       std::map<std::string, std::vector<api::types::v1::PackageInfoV2>> &list,
       const std::string &type) noexcept;
-    static void filterPackageInfosByType(std::vector<api::types::v1::PackageInfoDisplay> &list,
-                                         const std::string &type);
     static utils::error::Result<void> filterPackageInfosByVersion(
       std::map<std::string, std::vector<api::types::v1::PackageInfoV2>> &list) noexcept;
     void printProgress() noexcept;
@@ -195,6 +201,7 @@ private:
     utils::error::Result<std::filesystem::path> ensureCache(
       runtime::RunContext &runContext, const generator::ContainerCfgBuilder &cfgBuilder) noexcept;
     QDBusReply<QString> authorization();
+    utils::error::Result<void> ensurePackageManager() noexcept;
     void updateAM() noexcept;
 
 private Q_SLOTS:
@@ -220,7 +227,8 @@ private:
     runtime::ContainerBuilder &containerBuilder;
     repo::OSTreeRepo &repository;
     std::unique_ptr<InteractiveNotifier> notifier;
-    api::dbus::v1::PackageManager &pkgMan;
+    PackageManagerFactory pkgManFactory;
+    api::dbus::v1::PackageManager *pkgMan{ nullptr };
     QString taskObjectPath;
     api::dbus::v1::Task1 *task{ nullptr };
     linglong::api::types::v1::State lastState{ linglong::api::types::v1::State::Unknown };
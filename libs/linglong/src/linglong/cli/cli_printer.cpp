@@ -67,6 +67,15 @@ std::string adjustDisplayWidth(const QString &str, int targetWidth)
 }
 
 void CLIPrinter::printPackages(const std::vector<api::types::v1::PackageInfoDisplay> &list)
+{
+    this->beginPackages();
+    for (const auto &info : list) {
+        this->printPackageEntry(info);
+    }
+    this->endPackages();
+}
+
+void CLIPrinter::beginPackages()
 {
     std::cout << "\033[38;5;214m" << std::left << adjustDisplayWidth(qUtf8Printable(_("ID")), 43)
               << adjustDisplayWidth(qUtf8Printable(_("Name")), 33)
@@ -74,30 +83,38 @@ void CLIPrinter::printPackages(const std::vector<api::types::v1::PackageInfoDisp
               << adjustDisplayWidth(qUtf8Printable(_("Channel")), 16)
               << adjustDisplayWidth(qUtf8Printable(_("Module")), 12)
               << qUtf8Printable(_("Description")) << "\033[0m" << std::endl;
-    for (const auto &info : list) {
-        auto simpleDescription = QString::fromStdString(info.description.value_or("")).simplified();
-        auto simpleDescriptionWStr = simpleDescription.toStdWString();
-        auto simpleDescriptionWcswidth = wcswidth(simpleDescriptionWStr.c_str(), -1);
-        if (simpleDescriptionWcswidth > 56) {
-            simpleDescriptionWStr = subwstr(simpleDescriptionWStr, 53) + L"...";
-            simpleDescription = QString::fromStdWString(simpleDescriptionWStr);
-        }
+}
 
-        auto name = QString::fromStdString(info.name).simplified();
-        auto nameWStr = name.toStdWString();
-        auto nameWcswidth = wcswidth(nameWStr.c_str(), -1);
-        if (nameWcswidth > 33) {
-            nameWStr = subwstr(nameWStr, 29) + L"...";
-            nameWcswidth = wcswidth(nameWStr.c_str(), -1);
-            name = QString::fromStdWString(nameWStr);
-        }
-        auto nameStr = name.toStdString();
-        auto nameOffset = nameStr.size() - nameWcswidth;
-        std::cout << std::setw(43) << info.id + " " << std::setw(33 + nameOffset) << nameStr + " "
-                  << std::setw(16) << info.version + " " << std::setw(16) << info.channel + " "
-                  << std::setw(12) << info.packageInfoDisplayModule + " "
-                  << simpleDescription.toStdString() << std::endl;
+void CLIPrinter::printPackageEntry(const api::types::v1::PackageInfoDisplay &info)
+{
+    auto simpleDescription = QString::fromStdString(info.description.value_or("")).simplified();
+    auto simpleDescriptionWStr = simpleDescription.toStdWString();
+    auto simpleDescriptionWcswidth = wcswidth(simpleDescriptionWStr.c_str(), -1);
+    if (simpleDescriptionWcswidth > 56) {
+        simpleDescriptionWStr = subwstr(simpleDescriptionWStr, 53) + L"...";
+        simpleDescription = QString::fromStdWString(simpleDescriptionWStr);
     }
+
+    auto name = QString::fromStdString(info.name).simplified();
+    auto nameWStr = name.toStdWString();
+    auto nameWcswidth = wcswidth(nameWStr.c_str(), -1);
+    if (nameWcswidth > 33) {
+        nameWStr = subwstr(nameWStr, 29) + L"...";
+        nameWcswidth = wcswidth(nameWStr.c_str(), -1);
+        name = QString::fromStdWString(nameWStr);
+    }
+    auto nameStr = name.toStdString();
+    auto nameOffset = nameStr.size() - nameWcswidth;
+    // rows are not flushed one by one, the column widths are fixed so nothing needs to be buffered
+    std::cout << std::setw(43) << info.id + " " << std::setw(33 + nameOffset) << nameStr + " "
+              << std::setw(16) << info.version + " " << std::setw(16) << info.channel + " "
+              << std::setw(12) << info.packageInfoDisplayModule + " "
+              << simpleDescription.toStdString() << '\n';
+}
+
+void CLIPrinter::endPackages()
+{
+    std::cout.flush();
 }
 
 void CLIPrinter::printSearchResult(
@@ -108,28 +125,7 @@ void CLIPrinter::printSearchResult(
         return;
     }
 
-    // 搜索结果排序, 优先级为 repo > id > channel > module > version, 高版本在前
-    for (auto &[repo, packages] : list) {
-        std::sort(packages.begin(), packages.end(), [](const auto &lhs, const auto &rhs) {
-            if (lhs.id != rhs.id)
-                return lhs.id < rhs.id;
-            if (lhs.channel != rhs.channel)
-                return lhs.channel < rhs.channel;
-            if (lhs.packageInfoV2Module != rhs.packageInfoV2Module)
-                return lhs.packageInfoV2Module < rhs.packageInfoV2Module;
-
-            auto lhsVer = package::Version::parse(lhs.version.c_str());
-            if (!lhsVer) {
-                return false;
-            }
-            auto rhsVer = package::Version::parse(rhs.version.c_str());
-            if (!rhsVer) {
-                return false;
-            }
-
-            return *lhsVer > *rhsVer;
-        });
-    }
+    sortSearchResult(list);
 
     std::cout << "\033[38;5;214m" << std::left << adjustDisplayWidth(qUtf8Printable(_("ID")), 43)
               << adjustDisplayWidth(qUtf8Printable(_("Name")), 33)
@@ -163,9 +159,10 @@ void CLIPrinter::printSearchResult(
                       << nameStr + " " << std::setw(16) << pkg.version + " " << std::setw(16)
                       << pkg.channel + " " << std::setw(12) << pkg.packageInfoV2Module + " "
                       << std::setw(10) << pkgRepo + " " << simpleDescription.toStdString()
-                      << std::endl;
+                      << '\n';
         }
     }
+    std::cout.flush();
 }
 
 void CLIPrinter::printContainers(const std::vector<api::types::v1::CliContainer> &list)
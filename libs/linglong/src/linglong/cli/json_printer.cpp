@@ -31,7 +31,33 @@ void JSONPrinter::printPackage(const api::types::v1::PackageInfoV2 &info)
 
 void JSONPrinter::printPackages(const std::vector<api::types::v1::PackageInfoDisplay> &list)
 {
-    std::cout << nlohmann::json(list).dump() << std::endl;
+    this->beginPackages();
+    for (const auto &info : list) {
+        this->printPackageEntry(info);
+    }
+    this->endPackages();
+}
+
+// The array is written element by element, the output is the same as dumping the whole array,
+// but the json document of the whole list is never built.
+void JSONPrinter::beginPackages()
+{
+    this->firstEntry = true;
+    std::cout << '[';
+}
+
+void JSONPrinter::printPackageEntry(const api::types::v1::PackageInfoDisplay &info)
+{
+    if (!this->firstEntry) {
+        std::cout << ',';
+    }
+    this->firstEntry = false;
+    std::cout << nlohmann::json(info).dump();
+}
+
+void JSONPrinter::endPackages()
+{
+    std::cout << ']' << std::endl;
 }
 
 void JSONPrinter::printPackages(const std::vector<api::types::v1::PackageInfoV2> &list)
@@ -42,30 +68,29 @@ void JSONPrinter::printPackages(const std::vector<api::types::v1::PackageInfoV2>
 void JSONPrinter::printSearchResult(
   std::map<std::string, std::vector<api::types::v1::PackageInfoV2>> list)
 {
-    // 搜索结果排序, 优先级为 repo > id > channel > module > version, 高版本在前
-    for (auto &[repo, packages] : list) {
-        std::sort(packages.begin(), packages.end(), [](const auto &lhs, const auto &rhs) {
-            if (lhs.id != rhs.id)
-                return lhs.id < rhs.id;
-            if (lhs.channel != rhs.channel)
-                return lhs.channel < rhs.channel;
-            if (lhs.packageInfoV2Module != rhs.packageInfoV2Module)
-                return lhs.packageInfoV2Module < rhs.packageInfoV2Module;
-
-            auto lhsVer = package::Version::parse(lhs.version.c_str());
-            if (!lhsVer) {
-                return false;
+    sortSearchResult(list);
+
+    // same as dumping the whole map, but only one package is converted to json at a time
+    std::cout << '{';
+    bool firstRepo = true;
+    for (const auto &[repo, packages] : list) {
+        if (!firstRepo) {
+            std::cout << ',';
+        }
+        firstRepo = false;
+
+        std::cout << nlohmann::json(repo).dump() << ":[";
+        bool firstPackage = true;
+        for (const auto &pkg : packages) {
+            if (!firstPackage) {
+                std::cout << ',';
             }
-            auto rhsVer = package::Version::parse(rhs.version.c_str());
-            if (!rhsVer) {
-                return false;
-            }
-
-            return *lhsVer > *rhsVer;
-        });
+            firstPackage = false;
+            std::cout << nlohmann::json(pkg).dump();
+        }
+        std::cout << ']';
     }
-
-    std::cout << nlohmann::json(list).dump() << std::endl;
+    std::cout << '}' << std::endl;
 }
 
 void JSONPrinter::printPruneResult(const std::vector<api::types::v1::PackageInfoV2> &list)
@@ -21,6 +21,9 @@ public:
     void printErr(const utils::error::Error &) override;
     void printPackage(const api::types::v1::PackageInfoV2 &) override;
     void printPackages(const std::vector<api::types::v1::PackageInfoDisplay> &) override;
+    void beginPackages() override;
+    void printPackageEntry(const api::types::v1::PackageInfoDisplay &) override;
+    void endPackages() override;
     void
       printSearchResult(std::map<std::string, std::vector<api::types::v1::PackageInfoV2>>) override;
     void printPruneResult(const std::vector<api::types::v1::PackageInfoV2> &) override;
@@ -36,6 +39,9 @@ public:
     void printUpgradeList(std::vector<api::types::v1::UpgradeListResult> &) override;
     void printInspect(const api::types::v1::InspectResult &) override;
     void printMessage(const QString &message) override;
+
+private:
+    bool firstEntry{ true };
 };
 
 } // namespace linglong::cli
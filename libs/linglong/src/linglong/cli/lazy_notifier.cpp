@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "lazy_notifier.h"
+
+#include "dummy_notifier.h"
+
+namespace linglong::cli {
+
+LazyNotifier::LazyNotifier(Factory factory) noexcept
+    : factory(std::move(factory))
+{
+}
+
+InteractiveNotifier &LazyNotifier::get()
+{
+    if (!this->notifier && this->factory) {
+        this->notifier = this->factory();
+        this->factory = nullptr;
+    }
+
+    if (!this->notifier) {
+        qInfo() << "Using DummyNotifier, expected interactions and prompts will not be "
+                   "displayed.";
+        this->notifier = std::make_unique<DummyNotifier>();
+    }
+
+    return *this->notifier;
+}
+
+utils::error::Result<api::types::v1::InteractionReply>
+LazyNotifier::request(const api::types::v1::InteractionRequest &request)
+{
+    return this->get().request(request);
+}
+
+utils::error::Result<void> LazyNotifier::notify(const api::types::v1::InteractionRequest &request)
+{
+    return this->get().notify(request);
+}
+
+} // namespace linglong::cli
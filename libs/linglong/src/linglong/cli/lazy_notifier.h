@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "interactive_notifier.h"
+#include "linglong/api/types/v1/InteractionReply.hpp"
+#include "linglong/utils/error/error.h"
+
+#include <functional>
+#include <memory>
+
+namespace linglong::cli {
+
+// This notifier defers the creation of the real notifier until the first interaction.
+// Most invocations of ll-cli never interact with user, creating a DBusNotifier would
+// connect to the session bus and register match rules for nothing.
+class LazyNotifier final : public InteractiveNotifier
+{
+public:
+    using Factory = std::function<std::unique_ptr<InteractiveNotifier>()>;
+
+    explicit LazyNotifier(Factory factory) noexcept;
+    utils::error::Result<api::types::v1::InteractionReply>
+    request(const api::types::v1::InteractionRequest &request) override;
+    utils::error::Result<void> notify(const api::types::v1::InteractionRequest &request) override;
+
+private:
+    InteractiveNotifier &get();
+
+    Factory factory;
+    std::unique_ptr<InteractiveNotifier> notifier;
+};
+
+} // namespace linglong::cli
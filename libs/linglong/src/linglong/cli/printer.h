@@ -17,8 +17,12 @@
 #include "linglong/api/types/v1/SubState.hpp"
 #include "linglong/api/types/v1/UpgradeListResult.hpp"
 #include "linglong/cli/cli.h"
+#include "linglong/package/version.h"
 #include "linglong/utils/error/error.h"
 
+#include <algorithm>
+#include <numeric>
+
 namespace linglong::cli {
 
 inline std::string toString(linglong::api::types::v1::SubState subState) noexcept
@@ -65,6 +69,47 @@ inline std::string toString(linglong::api::types::v1::State state) noexcept
     }
 }
 
+// 搜索结果排序, 优先级为 repo > id > channel > module > version, 高版本在前
+// versions are parsed once before sorting instead of in every comparison
+inline void
+sortSearchResult(std::map<std::string, std::vector<api::types::v1::PackageInfoV2>> &list) noexcept
+{
+    for (auto &[repo, packages] : list) {
+        std::vector<std::optional<package::Version>> versions;
+        versions.reserve(packages.size());
+        for (const auto &pkg : packages) {
+            auto version = package::Version::parse(pkg.version.c_str());
+            versions.emplace_back(version ? std::make_optional(std::move(version).value())
+                                          : std::nullopt);
+        }
+
+        std::vector<std::size_t> indexes(packages.size());
+        std::iota(indexes.begin(), indexes.end(), 0);
+        std::sort(indexes.begin(), indexes.end(), [&packages, &versions](auto lhs, auto rhs) {
+            const auto &lhsPkg = packages[lhs];
+            const auto &rhsPkg = packages[rhs];
+            if (lhsPkg.id != rhsPkg.id)
+                return lhsPkg.id < rhsPkg.id;
+            if (lhsPkg.channel != rhsPkg.channel)
+                return lhsPkg.channel < rhsPkg.channel;
+            if (lhsPkg.packageInfoV2Module != rhsPkg.packageInfoV2Module)
+                return lhsPkg.packageInfoV2Module < rhsPkg.packageInfoV2Module;
+            if (!versions[lhs] || !versions[rhs]) {
+                return false;
+            }
+
+            return *versions[lhs] > *versions[rhs];
+        });
+
+        std::vector<api::types::v1::PackageInfoV2> sorted;
+        sorted.reserve(packages.size());
+        for (auto index : indexes) {
+            sorted.emplace_back(std::move(packages[index]));
+        }
+        packages = std::move(sorted);
+    }
+}
+
 class Printer
 {
 public:
@@ -78,6 +123,10 @@ public:
     virtual void printErr(const utils::error::Error &) = 0;
     virtual void printPackage(const api::types::v1::PackageInfoV2 &) = 0;
     virtual void printPackages(const std::vector<api::types::v1::PackageInfoDisplay> &) = 0;
+    // print packages one by one as soon as they are available, without collecting them first
+    virtual void beginPackages() = 0;
+    virtual void printPackageEntry(const api::types::v1::PackageInfoDisplay &) = 0;
+    virtual void endPackages() = 0;
     virtual void
       printSearchResult(std::map<std::string, std::vector<api::types::v1::PackageInfoV2>>) = 0;
     virtual void printPruneResult(const std::vector<api::types::v1::PackageInfoV2> &) = 0;
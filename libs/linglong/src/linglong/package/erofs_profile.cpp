@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "linglong/package/erofs_profile.h"
+
+#include "linglong/utils/command/cmd.h"
+
+#include <QStringList>
+
+#include <algorithm>
+#include <array>
+
+namespace linglong::package {
+
+namespace {
+
+// force 4096 block size in every profile, default is page size which is 16384 on loongarch64
+const std::array<ErofsProfile, 4> &profiles() noexcept
+{
+    static const std::array<ErofsProfile, 4> profiles{
+        ErofsProfile{
+          "default", "lz4", { "-Efragments,dedupe,ztailpacking", "-C1048576", "-b4096" } },
+        ErofsProfile{ "fast-build", "lz4", { "-Eztailpacking", "-b4096" } },
+        ErofsProfile{
+          "small", "lzma", { "-Efragments,dedupe,ztailpacking", "-C1048576", "-b4096" } },
+        ErofsProfile{ "fast-read", "lz4hc", { "-Eztailpacking", "-C65536", "-b4096" } },
+    };
+    return profiles;
+}
+
+} // namespace
+
+std::vector<std::string> ErofsProfile::args(const std::string &compressor) const
+{
+    std::vector<std::string> args{ "-z" + (compressor.empty() ? this->compressor : compressor) };
+    args.insert(args.end(), this->options.begin(), this->options.end());
+    return args;
+}
+
+const ErofsProfile &defaultErofsProfile() noexcept
+{
+    return profiles().front();
+}
+
+std::vector<std::string> erofsProfileNames() noexcept
+{
+    std::vector<std::string> names;
+    for (const auto &profile : profiles()) {
+        names.push_back(profile.name);
+    }
+
+    return names;
+}
+
+utils::error::Result<ErofsProfile> erofsProfile(const std::string &name) noexcept
+{
+    LINGLONG_TRACE("get erofs profile " + QString::fromStdString(name));
+
+    const auto &all = profiles();
+    auto it = std::find_if(all.begin(), all.end(), [&name](const ErofsProfile &profile) {
+        return profile.name == name;
+    });
+    if (it == all.end()) {
+        return LINGLONG_ERR("unknown erofs profile");
+    }
+
+    return *it;
+}
+
+utils::error::Result<void> packDir(const std::filesystem::path &dir,
+                                   const std::filesystem::path &image,
+                                   const ErofsProfile &profile,
+                                   const std::string &compressor) noexcept
+{
+    LINGLONG_TRACE(QString("pack %1 to %2 with erofs profile %3")
+                     .arg(dir.c_str(), image.c_str(), QString::fromStdString(profile.name)));
+
+    QStringList args;
+    for (const auto &arg : profile.args(compressor)) {
+        args.push_back(QString::fromStdString(arg));
+    }
+    args.push_back(image.c_str());
+    args.push_back(dir.c_str());
+
+    auto ret = utils::command::Cmd("mkfs.erofs").exec(args);
+    if (!ret) {
+        return LINGLONG_ERR(ret);
+    }
+
+    return LINGLONG_OK;
+}
+
+} // namespace linglong::package
@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "linglong/utils/error/error.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace linglong::package {
+
+// ErofsProfile is a set of mkfs.erofs parameters tuned for a kind of usage, see
+// https://github.com/erofs/erofs-utils/blob/master/README for the meaning of the options.
+//
+//   default     the parameters used before profiles were introduced
+//   fast-build  no deduplication and fragments, for CI builds
+//   small       lzma with deduplication and fragments, for releases
+//   fast-read   lz4hc with small physical clusters, for apps reading large assets randomly
+struct ErofsProfile
+{
+    std::string name;
+    std::string compressor;
+    // options except the compressor, the image and the source directory
+    std::vector<std::string> options;
+
+    // arguments of mkfs.erofs before the image and the source directory, compressor overrides
+    // the compressor of the profile if it's not empty
+    [[nodiscard]] std::vector<std::string> args(const std::string &compressor = {}) const;
+};
+
+[[nodiscard]] const ErofsProfile &defaultErofsProfile() noexcept;
+[[nodiscard]] std::vector<std::string> erofsProfileNames() noexcept;
+[[nodiscard]] utils::error::Result<ErofsProfile> erofsProfile(const std::string &name) noexcept;
+
+// packDir builds an erofs image from dir
+utils::error::Result<void> packDir(const std::filesystem::path &dir,
+                                   const std::filesystem::path &image,
+                                   const ErofsProfile &profile,
+                                   const std::string &compressor = {}) noexcept;
+
+} // namespace linglong::package
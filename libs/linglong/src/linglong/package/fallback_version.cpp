@@ -9,6 +9,8 @@
 #include "linglong/package/version.h"
 #include "linglong/package/versionv2.h"
 
+#include <algorithm>
+
 #if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
 namespace Qt {
 static auto SkipEmptyParts = QString::SkipEmptyParts;
@@ -27,6 +29,23 @@ utils::error::Result<FallbackVersion> FallbackVersion::parse(const QString &raw)
     return FallbackVersion(list);
 }
 
+std::optional<FallbackVersion> FallbackVersion::tryParse(std::string_view raw) noexcept
+{
+    QStringList list;
+    while (!raw.empty()) {
+        auto part = raw.substr(0, raw.find('.'));
+        if (!part.empty()) {
+            list.append(QString::fromUtf8(part.data(), static_cast<int>(part.size())));
+        }
+        raw.remove_prefix(std::min(part.size() + 1, raw.size()));
+    }
+
+    if (list.isEmpty()) {
+        return std::nullopt;
+    }
+    return FallbackVersion(list);
+}
+
 bool FallbackVersion::semanticMatch(const QString &versionStr) const noexcept
 {
     QStringList versionParts = versionStr.split('.', Qt::SkipEmptyParts);
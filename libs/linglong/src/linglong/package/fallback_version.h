@@ -9,6 +9,9 @@
 
 #include <QStringList>
 
+#include <optional>
+#include <string_view>
+
 namespace linglong::package {
 class VersionV2;
 class VersionV1;
@@ -17,6 +20,7 @@ class FallbackVersion
 {
 public:
     static utils::error::Result<FallbackVersion> parse(const QString &raw) noexcept;
+    static std::optional<FallbackVersion> tryParse(std::string_view raw) noexcept;
 
     explicit FallbackVersion(const QStringList &list)
         : list(list) { };
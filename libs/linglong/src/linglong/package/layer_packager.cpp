@@ -11,17 +11,25 @@
 #include "linglong/utils/command/cmd.h"
 #include "linglong/utils/command/env.h"
 
+#include <QCryptographicHash>
 #include <QDataStream>
 #include <QSysInfo>
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <string>
+#include <vector>
 
+#include <sys/stat.h>
 #include <unistd.h>
 
 namespace linglong::package {
 
+namespace {
+const auto ignoreRegex = QString{ "--exclude-regex=minified*" };
+} // namespace
+
 LayerPackager::LayerPackager()
 {
     this->initWorkDir();
@@ -92,7 +100,9 @@ LayerPackager::~LayerPackager()
 }
 
 utils::error::Result<QSharedPointer<LayerFile>>
-LayerPackager::pack(const LayerDir &dir, const QString &layerFilePath) const
+LayerPackager::pack(const LayerDir &dir,
+                    const QString &layerFilePath,
+                    const std::optional<std::string> &contentDigest) const
 {
     LINGLONG_TRACE("pack layer");
 
@@ -142,25 +152,40 @@ LayerPackager::pack(const LayerDir &dir, const QString &layerFilePath) const
 
     layer.close();
 
-    // compress data with erofs
-    const auto &compressedFilePath = this->workDir / "tmp.erofs";
-    const auto &ignoreRegex = QString{ "--exclude-regex=minified*" };
-    // 使用-b统一指定block size为4096(2^12), 避免不同系统的兼容问题
-    // loongarch64默认使用(16384)2^14, 在x86和arm64不受支持, 会导致无法推包
-    auto ret = utils::command::Cmd("mkfs.erofs")
-                 .exec({ "-z" + compressor,
-                         "-b4096",
-                         compressedFilePath.string().c_str(),
-                         ignoreRegex,
-                         dir.absolutePath() });
-    if (!ret) {
-        return LINGLONG_ERR(ret);
+    // 内容未变化时复用缓存的镜像，镜像缓存不可用时不影响打包
+    auto cacheFile = this->imageCacheFile(dir, contentDigest);
+    if (!cacheFile) {
+        qWarning() << "erofs image cache is disabled:" << cacheFile.error().message();
+        cacheFile = std::optional<std::filesystem::path>{};
     }
 
-    ret = utils::command::Cmd("sh").exec(
+    std::filesystem::path compressedFilePath = this->workDir / "tmp.erofs";
+    if (*cacheFile && std::filesystem::exists(**cacheFile)) {
+        qDebug() << "use cached erofs image" << (*cacheFile)->c_str();
+        compressedFilePath = **cacheFile;
+    } else {
+        // compress data with erofs
+        // 使用-b统一指定block size为4096(2^12), 避免不同系统的兼容问题
+        // loongarch64默认使用(16384)2^14, 在x86和arm64不受支持, 会导致无法推包
+        auto ret = utils::command::Cmd("mkfs.erofs")
+                     .exec({ "-z" + compressor,
+                             "-b4096",
+                             compressedFilePath.string().c_str(),
+                             ignoreRegex,
+                             dir.absolutePath() });
+        if (!ret) {
+            return LINGLONG_ERR(ret);
+        }
+
+        if (*cacheFile) {
+            this->storeImageCache(compressedFilePath, **cacheFile);
+        }
+    }
+
+    auto ret = utils::command::Cmd("sh").exec(
       { "-c", QString("cat %1 >> %2").arg(compressedFilePath.string().c_str(), layerFilePath) });
     if (!ret) {
-        LINGLONG_ERR(ret);
+        return LINGLONG_ERR(ret);
     }
 
     auto result = LayerFile::New(layerFilePath);
@@ -169,6 +194,119 @@ LayerPackager::pack(const LayerDir &dir, const QString &layerFilePath) const
     return result;
 }
 
+void LayerPackager::setImageCacheDir(const std::filesystem::path &dir) noexcept
+{
+    this->imageCacheDir = dir;
+}
+
+utils::error::Result<std::string> LayerPackager::digestOf(const LayerDir &dir) noexcept
+{
+    LINGLONG_TRACE("calculate digest of " + dir.absolutePath());
+
+    std::filesystem::path root = dir.absolutePath().toStdString();
+    std::vector<std::filesystem::path> entries;
+    std::error_code ec;
+    for (auto iter = std::filesystem::recursive_directory_iterator(root, ec);
+         iter != std::filesystem::recursive_directory_iterator();
+         iter.increment(ec)) {
+        if (ec) {
+            break;
+        }
+        entries.push_back(iter->path().lexically_relative(root));
+    }
+    if (ec) {
+        return LINGLONG_ERR("failed to iterate layer dir", ec);
+    }
+    // 遍历顺序与文件系统相关，排序后摘要才是稳定的
+    std::sort(entries.begin(), entries.end());
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    for (const auto &entry : entries) {
+        auto path = root / entry;
+        struct stat st{};
+        if (::lstat(path.c_str(), &st) == -1) {
+            return LINGLONG_ERR(QString("failed to stat %1").arg(path.c_str()), errno);
+        }
+
+        hash.addData(QByteArray::fromStdString(entry.string() + '\0'));
+        hash.addData(QByteArray::number(st.st_mode, 8) + '\0');
+        if (S_ISLNK(st.st_mode)) {
+            auto target = std::filesystem::read_symlink(path, ec);
+            if (ec) {
+                return LINGLONG_ERR(QString("failed to read link %1").arg(path.c_str()), ec);
+            }
+            hash.addData(QByteArray::fromStdString(target.string() + '\0'));
+        } else if (S_ISREG(st.st_mode)) {
+            QFile file(path.c_str());
+            if (!file.open(QIODevice::ReadOnly)) {
+                return LINGLONG_ERR(file);
+            }
+            QCryptographicHash content(QCryptographicHash::Sha256);
+            if (!content.addData(&file)) {
+                return LINGLONG_ERR(file);
+            }
+            hash.addData(content.result());
+        }
+    }
+
+    return hash.result().toHex().toStdString();
+}
+
+utils::error::Result<std::optional<std::filesystem::path>>
+LayerPackager::imageCacheFile(const LayerDir &dir,
+                              const std::optional<std::string> &contentDigest) const
+{
+    LINGLONG_TRACE("get erofs image cache file");
+
+    if (!this->imageCacheDir) {
+        return std::nullopt;
+    }
+
+    auto digest = contentDigest;
+    if (!digest) {
+        auto ret = digestOf(dir);
+        if (!ret) {
+            return LINGLONG_ERR(ret);
+        }
+        digest = std::move(ret).value();
+    }
+
+    // 镜像还与压缩参数相关
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(QByteArray::fromStdString(*digest));
+    hash.addData(("-z" + this->compressor + " -b4096 " + ignoreRegex).toUtf8());
+
+    std::error_code ec;
+    std::filesystem::create_directories(*this->imageCacheDir, ec);
+    if (ec) {
+        return LINGLONG_ERR("failed to create erofs image cache dir", ec);
+    }
+
+    return *this->imageCacheDir / (hash.result().toHex().toStdString() + ".erofs");
+}
+
+void LayerPackager::storeImageCache(const std::filesystem::path &image,
+                                    const std::filesystem::path &cacheFile) const noexcept
+{
+    // 先写入临时文件再重命名，避免其他进程读取到不完整的镜像
+    auto tmpFile = cacheFile;
+    tmpFile += "." + this->workDir.filename().string();
+
+    std::error_code ec;
+    std::filesystem::copy_file(image,
+                               tmpFile,
+                               std::filesystem::copy_options::overwrite_existing,
+                               ec);
+    if (!ec) {
+        std::filesystem::rename(tmpFile, cacheFile, ec);
+    }
+    if (ec) {
+        qWarning() << "failed to store erofs image cache" << cacheFile.c_str() << ":"
+                   << ec.message().c_str();
+        std::filesystem::remove(tmpFile, ec);
+    }
+}
+
 // 判断fd是否可在其他进程读取
 bool LayerPackager::isFileReadable(const std::string &path) const
 {
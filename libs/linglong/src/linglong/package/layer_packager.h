@@ -14,6 +14,7 @@
 #include <QUuid>
 
 #include <filesystem>
+#include <optional>
 #include <string>
 
 namespace linglong::package {
@@ -31,16 +32,30 @@ public:
     LayerPackager &operator=(const LayerPackager &) = delete;
     LayerPackager &operator=(LayerPackager &&) = delete;
     ~LayerPackager() override;
-    utils::error::Result<QSharedPointer<LayerFile>> pack(const LayerDir &dir,
-                                                         const QString &layerFilePath) const;
+    // contentDigest是layer目录内容的摘要，为空时通过遍历layer目录计算，仅在启用镜像缓存时使用
+    utils::error::Result<QSharedPointer<LayerFile>>
+    pack(const LayerDir &dir,
+         const QString &layerFilePath,
+         const std::optional<std::string> &contentDigest = std::nullopt) const;
     utils::error::Result<LayerDir> unpack(LayerFile &file);
     utils::error::Result<void> setCompressor(const QString &compressor) noexcept;
     const std::filesystem::path &getWorkDir() const;
+    // 设置erofs镜像的缓存目录，内容未变化的layer直接复用之前生成的镜像
+    void setImageCacheDir(const std::filesystem::path &dir) noexcept;
+    // 计算layer目录的内容摘要，包含文件路径、权限、文件内容和链接目标
+    static utils::error::Result<std::string> digestOf(const LayerDir &dir) noexcept;
 
 private:
     std::filesystem::path workDir;
     QString compressor = "lzma";
     bool isMounted = false;
+    std::optional<std::filesystem::path> imageCacheDir;
+    // 获取layer对应的缓存镜像路径，未启用缓存时返回空
+    utils::error::Result<std::optional<std::filesystem::path>>
+    imageCacheFile(const LayerDir &dir, const std::optional<std::string> &contentDigest) const;
+    // 保存生成的镜像到缓存目录
+    void storeImageCache(const std::filesystem::path &image,
+                         const std::filesystem::path &cacheFile) const noexcept;
     // 初始化工作目录
     utils::error::Result<void> initWorkDir();
     // 检查erofs-fuse命令是否存在
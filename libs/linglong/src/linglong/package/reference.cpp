@@ -6,49 +6,40 @@
 
 #include "linglong/package/reference.h"
 
-#include <qregularexpression.h>
+#include "linglong/package/version_parser.h"
 
 #include <QStringList>
 
 namespace linglong::package {
 
-utils::error::Result<Reference> Reference::parse(const std::string &raw) noexcept
+namespace {
+
+QString toQString(std::string_view str) noexcept
 {
-    return parse(QString::fromStdString(raw));
+    return QString::fromUtf8(str.data(), static_cast<int>(str.size()));
 }
 
-utils::error::Result<Reference> Reference::parse(const QString &raw) noexcept
+utils::error::Result<Reference> parseReference(std::string_view raw) noexcept
 {
     LINGLONG_TRACE("parse reference string");
 
-    static auto referenceRegExp = []() noexcept {
-        QRegularExpression referenceRegExp(
-          R"((?<channel>[^:]+):(?<id>[^\/]+)\/(?<version>[^\/]+)\/(?<architecture>[^\/]+))");
-        referenceRegExp.optimize();
-        return referenceRegExp;
-    }();
-
-    auto matches = referenceRegExp.match(raw);
-    if (not(matches.isValid() and matches.hasMatch())) {
-        return LINGLONG_ERR("regexp mismatched.", -1);
+    auto parts = splitReference(raw);
+    if (!parts) {
+        return LINGLONG_ERR("reference mismatched, it should be channel:id/version/arch", -1);
     }
 
-    auto channel = matches.captured("channel");
-    auto id = matches.captured("id");
-    auto versionStr = matches.captured("version");
-    auto architectureStr = matches.captured("architecture");
-
-    auto version = Version::parse(versionStr);
+    auto version = Version::tryParse(parts->version);
     if (!version) {
-        return LINGLONG_ERR(version);
+        return LINGLONG_ERR("parse version failed: " + toQString(parts->version));
     }
 
-    auto arch = Architecture::parse(architectureStr.toStdString());
+    auto arch = Architecture::parse(std::string{ parts->architecture });
     if (!arch) {
         return LINGLONG_ERR(arch);
     }
 
-    auto reference = create(channel, id, *version, *arch);
+    auto reference =
+      Reference::create(toQString(parts->channel), toQString(parts->id), *version, *arch);
     if (!reference) {
         return LINGLONG_ERR(reference);
     }
@@ -56,6 +47,19 @@ utils::error::Result<Reference> Reference::parse(const QString &raw) noexcept
     return *reference;
 }
 
+} // namespace
+
+utils::error::Result<Reference> Reference::parse(const std::string &raw) noexcept
+{
+    return parseReference(raw);
+}
+
+utils::error::Result<Reference> Reference::parse(const QString &raw) noexcept
+{
+    auto utf8 = raw.toUtf8();
+    return parseReference(std::string_view{ utf8.constData(), static_cast<size_t>(utf8.size()) });
+}
+
 utils::error::Result<Reference>
 Reference::fromPackageInfo(const api::types::v1::PackageInfoV2 &info) noexcept
 {
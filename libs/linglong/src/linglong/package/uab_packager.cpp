@@ -10,6 +10,7 @@
 #include "linglong/api/types/v1/Version.hpp"
 #include "linglong/package/architecture.h"
 #include "linglong/utils/command/cmd.h"
+#include "linglong/utils/disk_space.h"
 #include "linglong/utils/error/error.h"
 #include "linglong/utils/file.h"
 #include "linglong/utils/log/log.h"
@@ -225,6 +226,10 @@ utils::error::Result<void> UABPackager::pack(const QString &uabFilePath,
         return LINGLONG_ERR("uab-header is missing");
     }
 
+    if (auto ret = checkSpace(uabFilePath); !ret) {
+        return ret;
+    }
+
     auto uabApp = buildDir.filePath(".exported.uab");
     if (QFileInfo::exists(uabApp) && !QFile::remove(uabApp)) {
         return LINGLONG_ERR("couldn't remove uab cache");
@@ -276,6 +281,42 @@ utils::error::Result<void> UABPackager::pack(const QString &uabFilePath,
     return LINGLONG_OK;
 }
 
+// The size of the layers is an upper bound of the bundle, the erofs image and the uab, so
+// exporting a large application fails early instead of after minutes of compressing.
+utils::error::Result<void> UABPackager::checkSpace(const QString &uabFilePath) noexcept
+{
+    LINGLONG_TRACE("check space for uab")
+
+    utils::DirectoryUsage usage;
+    for (const auto &layer : std::as_const(this->layers)) {
+        auto ret = utils::directoryUsage(layer.absolutePath().toStdString());
+        if (!ret) {
+            return LINGLONG_ERR(ret);
+        }
+        usage.bytes += ret->bytes;
+        usage.inodes += ret->inodes;
+    }
+
+    // the bundle dir is copied if the layers are on another filesystem, then it is packed to
+    // the erofs image and objcopy writes a new uab with the image before replacing the old one
+    auto buildPath = buildDir.absolutePath().toStdString();
+    std::vector<utils::SpaceRequirement> requirements{
+        { buildPath, usage.bytes * 3, usage.inodes + 8 },
+    };
+
+    // rename copies the uab if the export path is on another filesystem
+    auto exportPath = QFileInfo{ uabFilePath }.absoluteFilePath().toStdString();
+    auto sameFilesystem = utils::isSameFilesystem(buildPath, exportPath);
+    if (!sameFilesystem) {
+        return LINGLONG_ERR(sameFilesystem);
+    }
+    if (!*sameFilesystem) {
+        requirements.push_back({ exportPath, usage.bytes, 1 });
+    }
+
+    return utils::checkDiskSpace(requirements);
+}
+
 utils::error::Result<void> UABPackager::packIcon() noexcept
 {
     LINGLONG_TRACE("add icon to uab")
@@ -929,14 +970,10 @@ utils::error::Result<void> UABPackager::packBundle(bool distributedOnly) noexcep
             return LINGLONG_ERR("bundle error", ret);
         }
     } else {
-        // https://github.com/erofs/erofs-utils/blob/b526c0d7da46b14f1328594cf1d1b2401770f59b/README#L171-L183
-        if (auto ret = utils::command::Cmd("mkfs.erofs")
-                         .exec({ "-z" + compressor,
-                                 "-Efragments,dedupe,ztailpacking",
-                                 "-C1048576",
-                                 "-b4096", // force 4096 block size, default is page size
-                                 bundleFile,
-                                 bundleDir.absolutePath() });
+        if (auto ret = packDir(bundleDir.absolutePath().toStdString(),
+                               bundleFile.toStdString(),
+                               this->erofsProfile,
+                               this->compressor.toStdString());
             !ret) {
             return LINGLONG_ERR(ret);
         }
@@ -1208,6 +1245,11 @@ void UABPackager::setCompressor(const QString &compressor) noexcept
     this->compressor = compressor;
 }
 
+void UABPackager::setErofsProfile(ErofsProfile profile) noexcept
+{
+    this->erofsProfile = std::move(profile);
+}
+
 void UABPackager::setDefaultHeader(const QString &header) noexcept
 {
     this->defaultHeader = header;
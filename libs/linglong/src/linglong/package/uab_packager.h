@@ -5,6 +5,7 @@
 #pragma once
 
 #include "linglong/api/types/v1/UabMetaInfo.hpp"
+#include "linglong/package/erofs_profile.h"
 #include "linglong/package/layer_dir.h"
 #include "linglong/utils/error/error.h"
 
@@ -62,6 +63,8 @@ private:
 
 class UABPackager
 {
+    friend class UABPackagerBenchmark;
+
 public:
     explicit UABPackager(const QDir &projectDir, QDir workingDir);
     ~UABPackager();
@@ -77,6 +80,7 @@ public:
     utils::error::Result<void> loadNeededFiles() noexcept;
     void setLoader(const QString &loader) noexcept;
     void setCompressor(const QString &compressor) noexcept;
+    void setErofsProfile(ErofsProfile profile) noexcept;
     void setDefaultHeader(const QString &header) noexcept;
     void setDefaultLoader(const QString &loader) noexcept;
     void setDefaultBox(const QString &box) noexcept;
@@ -84,6 +88,7 @@ public:
                        bundleCB) noexcept;
 
 private:
+    [[nodiscard]] utils::error::Result<void> checkSpace(const QString &uabFilePath) noexcept;
     [[nodiscard]] utils::error::Result<void> packIcon() noexcept;
     [[nodiscard]] utils::error::Result<void> packBundle(bool distributed) noexcept;
     [[nodiscard]] utils::error::Result<void>
@@ -106,6 +111,7 @@ private:
     std::filesystem::path workDir;
     QString loader;
     QString compressor = "lz4";
+    ErofsProfile erofsProfile = defaultErofsProfile();
     QString defaultHeader;
     QString defaultLoader;
     QString defaultBox;
@@ -24,27 +24,39 @@ namespace linglong::package {
 utils::error::Result<Version> Version::parse(const QString &raw,
                                              const ParseOptions parseOpt) noexcept
 {
-    LINGLONG_TRACE(QString("parse version %1").arg(raw));
+    auto utf8 = raw.toUtf8();
+    auto version =
+      tryParse(std::string_view{ utf8.constData(), static_cast<size_t>(utf8.size()) }, parseOpt);
+    if (!version) {
+        LINGLONG_TRACE(QString("parse version %1").arg(raw));
+        return LINGLONG_ERR("parse version failed");
+    }
+
+    return *std::move(version);
+}
 
-    auto versionV2 = VersionV2::parse(raw, parseOpt.strict);
+std::optional<Version> Version::tryParse(std::string_view raw,
+                                         const ParseOptions parseOpt) noexcept
+{
+    auto versionV2 = VersionV2::tryParse(raw, parseOpt.strict);
     if (versionV2) {
-        return Version(*versionV2);
+        return Version(*std::move(versionV2));
     }
 
     if (!parseOpt.fallback) {
-        return LINGLONG_ERR("parse version failed");
+        return std::nullopt;
     }
 
-    auto versionV1 = VersionV1::parse(raw);
+    auto versionV1 = VersionV1::tryParse(raw);
     if (versionV1) {
         return Version(*versionV1);
     }
 
-    auto fallbackVersion = FallbackVersion::parse(raw);
+    auto fallbackVersion = FallbackVersion::tryParse(raw);
     if (fallbackVersion) {
-        return Version(*fallbackVersion);
+        return Version(*std::move(fallbackVersion));
     }
-    return LINGLONG_ERR("parse version failed");
+    return std::nullopt;
 }
 
 utils::error::Result<void> Version::validateDependVersion(const QString &raw) noexcept
@@ -68,9 +80,9 @@ std::vector<linglong::api::types::v1::PackageInfoV2> Version::filterByFuzzyVersi
   std::vector<linglong::api::types::v1::PackageInfoV2> list, const QString &fuzzyVersion)
 {
     for (auto it = list.begin(); it != list.end();) {
-        auto packageVerRet = package::Version::parse(it->version.c_str());
+        auto packageVerRet = package::Version::tryParse(it->version);
         if (!packageVerRet) {
-            qWarning() << "Ignore invalid package record " << packageVerRet.error();
+            qWarning() << "Ignore invalid package record " << it->version.c_str();
             it = list.erase(it);
             continue;
         }
@@ -84,7 +96,7 @@ std::vector<linglong::api::types::v1::PackageInfoV2> Version::filterByFuzzyVersi
     return list;
 }
 
-bool Version::semanticMatch(const QString &versionStr)
+bool Version::semanticMatch(const QString &versionStr) const
 {
     if (std::holds_alternative<VersionV1>(version)) {
         return std::get<VersionV1>(version).semanticMatch(versionStr);
@@ -14,6 +14,8 @@
 
 #include <QString>
 
+#include <optional>
+#include <string_view>
 #include <variant>
 
 namespace linglong::package {
@@ -30,10 +32,14 @@ public:
     static utils::error::Result<Version> parse(const QString &raw,
                                                const ParseOptions parseOpt = {
                                                  .strict = true, .fallback = true }) noexcept;
+    // same as parse, but the failure is cheap, for trying to parse a lot of strings
+    static std::optional<Version> tryParse(std::string_view raw,
+                                           const ParseOptions parseOpt = {
+                                             .strict = true, .fallback = true }) noexcept;
 
     static std::vector<linglong::api::types::v1::PackageInfoV2> filterByFuzzyVersion(
       std::vector<linglong::api::types::v1::PackageInfoV2> list, const QString &fuzzyVersion);
-    bool semanticMatch(const QString &versionStr);
+    bool semanticMatch(const QString &versionStr) const;
 
     static utils::error::Result<void> validateDependVersion(const QString &raw) noexcept;
     explicit Version(const QString &raw) = delete;
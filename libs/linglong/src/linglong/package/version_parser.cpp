@@ -0,0 +1,263 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "linglong/package/version_parser.h"
+
+#include <array>
+#include <limits>
+
+namespace linglong::package {
+
+namespace {
+
+bool isDigit(char c) noexcept
+{
+    return c >= '0' && c <= '9';
+}
+
+bool isIdentifierChar(char c) noexcept
+{
+    return isDigit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '-';
+}
+
+// `$` of the regular expressions also matches before a newline at the end
+std::string_view withoutTrailingNewline(std::string_view str) noexcept
+{
+    if (!str.empty() && str.back() == '\n') {
+        str.remove_suffix(1);
+    }
+    return str;
+}
+
+bool consume(std::string_view &str, char c) noexcept
+{
+    if (str.empty() || str.front() != c) {
+        return false;
+    }
+    str.remove_prefix(1);
+    return true;
+}
+
+// digits which fit in a uint64_t, like std::stoull
+std::optional<uint64_t> toNumber(std::string_view digits) noexcept
+{
+    if (digits.empty()) {
+        return std::nullopt;
+    }
+
+    uint64_t value = 0;
+    for (auto c : digits) {
+        if (!isDigit(c)) {
+            return std::nullopt;
+        }
+
+        auto digit = static_cast<uint64_t>(c - '0');
+        if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10) {
+            return std::nullopt;
+        }
+        value = value * 10 + digit;
+    }
+
+    return value;
+}
+
+// 0|[1-9]\d*
+std::optional<uint64_t> takeNumber(std::string_view &str) noexcept
+{
+    if (str.empty() || !isDigit(str.front())) {
+        return std::nullopt;
+    }
+
+    std::size_t length = 1;
+    if (str.front() != '0') {
+        while (length < str.size() && isDigit(str[length])) {
+            ++length;
+        }
+    }
+
+    auto number = toNumber(str.substr(0, length));
+    str.remove_prefix(length);
+    return number;
+}
+
+// [0-9a-zA-Z-]+
+std::string_view takeIdentifier(std::string_view &str) noexcept
+{
+    std::size_t length = 0;
+    while (length < str.size() && isIdentifierChar(str[length])) {
+        ++length;
+    }
+
+    auto identifier = str.substr(0, length);
+    str.remove_prefix(length);
+    return identifier;
+}
+
+// a numeric identifier of the prerelease has no leading zero and must be parsed as a number
+bool isValidPrereleaseIdentifier(std::string_view identifier) noexcept
+{
+    if (identifier.empty()) {
+        return false;
+    }
+
+    for (auto c : identifier) {
+        if (!isDigit(c)) {
+            return true;
+        }
+    }
+
+    return (identifier.size() == 1 || identifier.front() != '0')
+      && toNumber(identifier).has_value();
+}
+
+// the build metadata may contain "security.N" which N is a positive number
+std::optional<uint64_t> securityOf(std::string_view buildMeta) noexcept
+{
+    constexpr std::string_view prefix = "security.";
+    auto pos = buildMeta.find(prefix);
+    if (pos == std::string_view::npos) {
+        return 0;
+    }
+
+    auto security = buildMeta.substr(pos + prefix.size());
+    if (security.size() > 1 && security.front() == '0') {
+        return std::nullopt;
+    }
+
+    auto value = toNumber(security);
+    if (!value || *value == 0) {
+        return std::nullopt;
+    }
+
+    return value;
+}
+
+} // namespace
+
+std::optional<SemverParts> parseSemver(std::string_view raw, bool strict) noexcept
+{
+    auto str = withoutTrailingNewline(raw);
+    if (!strict) {
+        consume(str, 'v');
+    }
+
+    SemverParts parts;
+    auto major = takeNumber(str);
+    if (!major || !consume(str, '.')) {
+        return std::nullopt;
+    }
+    auto minor = takeNumber(str);
+    if (!minor) {
+        return std::nullopt;
+    }
+    parts.major = *major;
+    parts.minor = *minor;
+
+    if (strict || (!str.empty() && str.front() == '.')) {
+        if (!consume(str, '.')) {
+            return std::nullopt;
+        }
+
+        auto patch = takeNumber(str);
+        if (!patch) {
+            return std::nullopt;
+        }
+        parts.patch = *patch;
+        parts.hasPatch = true;
+    }
+
+    if (consume(str, '-')) {
+        auto begin = str.data();
+        do {
+            if (!isValidPrereleaseIdentifier(takeIdentifier(str))) {
+                return std::nullopt;
+            }
+        } while (consume(str, '.'));
+        parts.prerelease = std::string_view(begin, str.data() - begin);
+    }
+
+    if (consume(str, '+')) {
+        auto begin = str.data();
+        do {
+            if (takeIdentifier(str).empty()) {
+                return std::nullopt;
+            }
+        } while (consume(str, '.'));
+        parts.buildMeta = std::string_view(begin, str.data() - begin);
+
+        auto security = securityOf(parts.buildMeta);
+        if (!security) {
+            return std::nullopt;
+        }
+        parts.security = *security;
+    }
+
+    if (!str.empty()) {
+        return std::nullopt;
+    }
+
+    return parts;
+}
+
+std::optional<VersionV1Parts> parseVersionV1(std::string_view raw) noexcept
+{
+    constexpr auto max = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    auto str = withoutTrailingNewline(raw);
+
+    std::array<int64_t, 4> numbers{};
+    std::size_t count = 0;
+    do {
+        auto number = takeNumber(str);
+        if (!number || *number > max) {
+            return std::nullopt;
+        }
+        numbers[count++] = static_cast<int64_t>(*number);
+    } while (count < numbers.size() && consume(str, '.'));
+
+    if (count < 3 || !str.empty()) {
+        return std::nullopt;
+    }
+
+    VersionV1Parts parts{ .major = numbers[0], .minor = numbers[1], .patch = numbers[2] };
+    if (count == 4) {
+        parts.tweak = numbers[3];
+    }
+
+    return parts;
+}
+
+std::optional<ReferenceParts> splitReference(std::string_view raw) noexcept
+{
+    // The reference regular expression isn't anchored, its leftmost match is searched. The
+    // channel ends at a colon, and whether the rest matches only depends on that colon, so
+    // the colons are tried in turn. Anything after the architecture is ignored.
+    std::size_t begin = 0;
+    while (true) {
+        auto colon = raw.find(':', begin);
+        if (colon == std::string_view::npos) {
+            return std::nullopt;
+        }
+
+        auto idEnd = raw.find('/', colon + 1);
+        auto versionEnd =
+          idEnd == std::string_view::npos ? std::string_view::npos : raw.find('/', idEnd + 1);
+        if (colon > begin && idEnd != std::string_view::npos && idEnd > colon + 1
+            && versionEnd != std::string_view::npos && versionEnd > idEnd + 1
+            && versionEnd + 1 < raw.size() && raw[versionEnd + 1] != '/') {
+            auto architecture = raw.substr(versionEnd + 1);
+            return ReferenceParts{
+                .channel = raw.substr(begin, colon - begin),
+                .id = raw.substr(colon + 1, idEnd - colon - 1),
+                .version = raw.substr(idEnd + 1, versionEnd - idEnd - 1),
+                .architecture = architecture.substr(0, architecture.find('/')),
+            };
+        }
+
+        begin = colon + 1;
+    }
+}
+
+} // namespace linglong::package
@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+// Hand written parsers of the version and reference strings. They accept the same strings as
+// the regular expressions used before, including the trailing newline matched by `$`, don't
+// allocate and return std::nullopt on failure, so trying several grammars in turn is cheap.
+
+namespace linglong::package {
+
+// MAJOR.MINOR.PATCH[-PRERELEASE][+BUILD], see semver::version_pattern. In non-strict mode a
+// leading 'v' is allowed and PATCH is optional, see semver::loose_version_pattern.
+struct SemverParts
+{
+    uint64_t major{ 0 };
+    uint64_t minor{ 0 };
+    uint64_t patch{ 0 };
+    std::string_view prerelease;
+    std::string_view buildMeta;
+    uint64_t security{ 0 };
+    bool hasPatch{ false };
+};
+
+std::optional<SemverParts> parseSemver(std::string_view raw, bool strict) noexcept;
+
+// MAJOR.MINOR.PATCH[.TWEAK], every number fits in a qlonglong
+struct VersionV1Parts
+{
+    int64_t major{ 0 };
+    int64_t minor{ 0 };
+    int64_t patch{ 0 };
+    std::optional<int64_t> tweak;
+};
+
+std::optional<VersionV1Parts> parseVersionV1(std::string_view raw) noexcept;
+
+// CHANNEL:ID/VERSION/ARCH, the fields are not validated
+struct ReferenceParts
+{
+    std::string_view channel;
+    std::string_view id;
+    std::string_view version;
+    std::string_view architecture;
+};
+
+std::optional<ReferenceParts> splitReference(std::string_view raw) noexcept;
+
+} // namespace linglong::package
@@ -7,11 +7,9 @@
 #include "linglong/package/versionv1.h"
 
 #include "linglong/package/fallback_version.h"
+#include "linglong/package/version_parser.h"
 #include "linglong/package/versionv2.h"
 
-#include <QRegularExpression>
-#include <QRegularExpressionMatch>
-
 namespace linglong::package {
 utils::error::Result<VersionV1> VersionV1::parse(const QString &raw) noexcept
 try {
@@ -21,42 +19,31 @@ try {
     return LINGLONG_ERR(e);
 }
 
-VersionV1::VersionV1(const QString &raw)
+std::optional<VersionV1> VersionV1::tryParse(std::string_view raw) noexcept
 {
-    // modified from https://regex101.com/r/vkijKf/1/
-    static auto regexExp = []() noexcept {
-        QRegularExpression regexExp(
-          R"(^(0|[1-9]\d*)\.(0|[1-9]\d*)\.(0|[1-9]\d*)(?:\.(0|[1-9]\d*))?$)");
-        regexExp.optimize();
-        return regexExp;
-    }();
+    auto parts = parseVersionV1(raw);
+    if (!parts) {
+        return std::nullopt;
+    }
 
-    QRegularExpressionMatch matched = regexExp.match(raw);
+    VersionV1 version;
+    version.major = parts->major;
+    version.minor = parts->minor;
+    version.patch = parts->patch;
+    version.tweak = parts->tweak;
+    return version;
+}
 
-    if (!matched.hasMatch()) {
+VersionV1::VersionV1(const QString &raw)
+{
+    auto utf8 = raw.toUtf8();
+    auto version = tryParse(std::string_view{ utf8.constData(), static_cast<size_t>(utf8.size()) });
+    if (!version) {
         throw std::runtime_error(
           "version regex mismatched, please use four digits version like 1.0.0.0");
     }
 
-    bool ok = false;
-    this->major = matched.captured(1).toLongLong(&ok);
-    if (!ok) {
-        throw std::runtime_error("major too large");
-    }
-    this->minor = matched.captured(2).toLongLong(&ok);
-    if (!ok) {
-        throw std::runtime_error("minor too large");
-    }
-    this->patch = matched.captured(3).toLongLong(&ok);
-    if (!ok) {
-        throw std::runtime_error("patch too large");
-    }
-    if (!matched.captured(4).isNull()) {
-        this->tweak = matched.captured(4).toLongLong(&ok);
-        if (!ok) {
-            throw std::runtime_error("tweak too large");
-        }
-    }
+    *this = *version;
 }
 
 bool VersionV1::semanticMatch(const QString &versionStr) const noexcept
@@ -12,6 +12,7 @@
 #include <QString>
 
 #include <optional>
+#include <string_view>
 
 namespace linglong::package {
 class VersionV2;
@@ -22,6 +23,7 @@ class VersionV1 final
 {
 public:
     static utils::error::Result<VersionV1> parse(const QString &raw) noexcept;
+    static std::optional<VersionV1> tryParse(std::string_view raw) noexcept;
     explicit VersionV1(const QString &raw);
     qlonglong major = 0;
     qlonglong minor = 0;
@@ -53,5 +55,8 @@ public:
     friend bool operator>=(const VersionV1 &v1, const FallbackVersion &fv) noexcept;
 
     QString toString() const noexcept;
+
+private:
+    VersionV1() noexcept = default;
 };
 } // namespace linglong::package
@@ -8,6 +8,7 @@
 
 #include "linglong/package/fallback_version.h"
 #include "linglong/package/semver.hpp"
+#include "linglong/package/version_parser.h"
 #include "linglong/package/versionv1.h"
 
 #include <QRegularExpression>
@@ -15,20 +16,31 @@
 namespace linglong::package {
 utils::error::Result<VersionV2> VersionV2::parse(const QString &raw, bool strict) noexcept
 {
-    LINGLONG_TRACE("parse version v2 " + raw);
-    try {
-        auto semverVersion = semver::version::parse(raw.toStdString(), strict);
-
-        return VersionV2(semverVersion.major(),
-                         semverVersion.minor(),
-                         semverVersion.patch(),
-                         semverVersion.prerelease(),
-                         semverVersion.build_meta(),
-                         semverVersion.security(),
-                         semverVersion.has_patch());
-    } catch (const semver::semver_exception &e) {
-        return LINGLONG_ERR(e.what());
+    auto utf8 = raw.toUtf8();
+    auto version = tryParse(std::string_view{ utf8.constData(), static_cast<size_t>(utf8.size()) },
+                            strict);
+    if (!version) {
+        LINGLONG_TRACE("parse version v2 " + raw);
+        return LINGLONG_ERR("Invalid version: " + raw);
     }
+
+    return *std::move(version);
+}
+
+std::optional<VersionV2> VersionV2::tryParse(std::string_view raw, bool strict) noexcept
+{
+    auto parts = parseSemver(raw, strict);
+    if (!parts) {
+        return std::nullopt;
+    }
+
+    return VersionV2(parts->major,
+                     parts->minor,
+                     parts->patch,
+                     std::string{ parts->prerelease },
+                     std::string{ parts->buildMeta },
+                     parts->security,
+                     parts->hasPatch);
 }
 
 VersionV2::VersionV2(uint64_t major,
@@ -8,6 +8,9 @@
 
 #include "linglong/utils/error/error.h"
 
+#include <optional>
+#include <string_view>
+
 namespace linglong::package {
 class VersionV1;
 class FallbackVersion;
@@ -16,6 +19,7 @@ class VersionV2 final
 {
 public:
     static utils::error::Result<VersionV2> parse(const QString &raw, bool strict = true) noexcept;
+    static std::optional<VersionV2> tryParse(std::string_view raw, bool strict = true) noexcept;
     explicit VersionV2(uint64_t major = 0,
                        uint64_t minor = 0,
                        uint64_t patch = 0,
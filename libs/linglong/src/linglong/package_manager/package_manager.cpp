@@ -32,6 +32,7 @@
 #include "linglong/utils/log/log.h"
 #include "linglong/utils/packageinfo_handler.h"
 #include "linglong/utils/serialize/json.h"
+#include "linglong/utils/trace/span.h"
 #include "linglong/utils/transaction.h"
 #include "ocppi/runtime/RunOption.hpp"
 
@@ -48,6 +49,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <map>
 #include <utility>
 
 #include <fcntl.h>
@@ -132,6 +134,65 @@ fuzzyReferenceFromPackage(const api::types::v1::PackageManager1Package &pkg) noe
                                                     std::nullopt);
     return fuzzyRef;
 }
+
+// Apply the filters of search parameters in package manager, so that the records which would be
+// dropped by client anyway are not sent over DBus.
+void filterSearchResult(std::vector<api::types::v1::PackageInfoV2> &pkgs,
+                        const api::types::v1::PackageManager1SearchParameters &params) noexcept
+{
+    pkgs.erase(std::remove_if(pkgs.begin(),
+                              pkgs.end(),
+                              [&params](const api::types::v1::PackageInfoV2 &pkg) {
+                                  if (params.kind && *params.kind != "all"
+                                      && pkg.kind != *params.kind) {
+                                      return true;
+                                  }
+
+                                  if (!params.excludeModules) {
+                                      return false;
+                                  }
+
+                                  const auto &modules = *params.excludeModules;
+                                  return std::find(modules.begin(),
+                                                   modules.end(),
+                                                   pkg.packageInfoV2Module)
+                                    != modules.end();
+                              }),
+               pkgs.end());
+
+    if (!params.latestOnly.value_or(false)) {
+        return;
+    }
+
+    // keep the latest version of each module of a package, versions are parsed only once
+    std::map<std::pair<std::string, std::string>, std::pair<package::Version, std::size_t>> latest;
+    for (std::size_t i = 0; i < pkgs.size(); ++i) {
+        auto version = package::Version::tryParse(pkgs[i].version);
+        if (!version) {
+            qWarning() << "failed to parse version:" << pkgs[i].version.c_str();
+            continue;
+        }
+
+        auto key = std::make_pair(pkgs[i].id, pkgs[i].packageInfoV2Module);
+        auto it = latest.find(key);
+        if (it == latest.end()) {
+            latest.emplace(std::move(key), std::make_pair(std::move(version).value(), i));
+            continue;
+        }
+
+        if (it->second.first < *version) {
+            it->second = std::make_pair(std::move(version).value(), i);
+        }
+    }
+
+    std::vector<api::types::v1::PackageInfoV2> filtered;
+    filtered.reserve(latest.size());
+    for (auto &[_, item] : latest) {
+        filtered.emplace_back(std::move(pkgs[item.second]));
+    }
+
+    pkgs = std::move(filtered);
+}
 } // namespace
 
 PackageManager::PackageManager(linglong::repo::OSTreeRepo &repo,
@@ -1373,6 +1434,21 @@ auto PackageManager::Install(const QVariantMap &parameters) noexcept -> QVariant
                             reply);
                         loop.exit(0);
                     });
+            // 用户确认前先获取需要升级的模块和commit，确认后可以直接下载数据
+            QTimer::singleShot(0, &loop, [this, &remoteRef, &localRef, &modules, &originalRepo] {
+                auto remoteModules = this->repo.getRemoteModuleList(
+                  remoteRef,
+                  localRef.has_value() ? this->repo.getModuleList(*localRef) : modules,
+                  originalRepo);
+                if (!remoteModules) {
+                    qDebug() << "prefetch upgrade failed:" << remoteModules.error().message();
+                    return;
+                }
+
+                for (const auto &module : *remoteModules) {
+                    this->repo.prefetch(remoteRef, module, originalRepo);
+                }
+            });
             loop.exec();
             if (interactionReply.action != "yes") {
                 taskRef.updateState(linglong::api::types::v1::State::Canceled, "canceled");
@@ -1514,7 +1590,7 @@ void PackageManager::InstallRef(PackageTask &taskContext,
                                 std::vector<std::string> modules,
                                 const api::types::v1::Repo &repo) noexcept
 {
-    LINGLONG_TRACE("install " + ref.toString());
+    LINGLONG_TRACE_SPAN("install " + ref.toString());
 
     taskContext.updateSubState(linglong::api::types::v1::SubState::PreAction,
                                "Beginning to install");
@@ -1741,7 +1817,7 @@ void PackageManager::UninstallRef(PackageTask &taskContext,
                                   const package::Reference &ref,
                                   const std::vector<std::string> &modules) noexcept
 {
-    LINGLONG_TRACE("uninstall ref " + ref.toString());
+    LINGLONG_TRACE_SPAN("uninstall ref " + ref.toString());
     if (isTaskDone(taskContext.subState())) {
         return;
     }
@@ -1920,7 +1996,7 @@ void PackageManager::Update(PackageTask &taskContext,
                             const package::Reference &oldRef,
                             const package::ReferenceWithRepo &refWithRepo) noexcept
 {
-    LINGLONG_TRACE("update " + oldRef.toString());
+    LINGLONG_TRACE_SPAN("update " + oldRef.toString());
 
     const auto &newRef = refWithRepo.reference;
     taskContext.updateState(api::types::v1::State::Processing, "start to uninstalling package");
@@ -2021,6 +2097,10 @@ auto PackageManager::Search(const QVariantMap &parameters) noexcept -> QVariantM
                             params = std::move(paras).value(),
                             ref = std::move(*fuzzyRef),
                             repo = std::move(repoConfig)]() {
+        if (params.refresh.value_or(false)) {
+            this->repo.clearRemoteSearchCache();
+        }
+
         std::map<std::string, std::vector<api::types::v1::PackageInfoV2>> pkgs;
         for (const auto &repoAlias : params.repos) {
             auto repoRet = this->repo.getRepoByAlias(repoAlias);
@@ -2038,6 +2118,7 @@ auto PackageManager::Search(const QVariantMap &parameters) noexcept -> QVariantM
                 return;
             }
 
+            filterSearchResult(*pkgInfosRet, params);
             if (pkgInfosRet->empty()) {
                 continue;
             }
@@ -2075,7 +2156,7 @@ void PackageManager::pullDependency(PackageTask &taskContext,
         return;
     }
 
-    LINGLONG_TRACE("pull dependencies of " + QString::fromStdString(info.id));
+    LINGLONG_TRACE_SPAN("pull dependencies of " + QString::fromStdString(info.id));
 
     utils::Transaction transaction;
     if (info.runtime) {
@@ -2247,7 +2328,7 @@ auto PackageManager::Prune() noexcept -> QVariantMap
 utils::error::Result<void>
 PackageManager::Prune(std::vector<api::types::v1::PackageInfoV2> &removed) noexcept
 {
-    LINGLONG_TRACE("prune");
+    LINGLONG_TRACE_SPAN("prune");
     auto pkgsInfo = this->repo.listLocal();
     if (!pkgsInfo) {
         return LINGLONG_ERR(pkgsInfo);
@@ -2396,7 +2477,7 @@ void PackageManager::ReplyInteraction([[maybe_unused]] QDBusObjectPath object_pa
 
 utils::error::Result<void> PackageManager::generateCache(const package::Reference &ref) noexcept
 {
-    LINGLONG_TRACE("generate cache for " + ref.toString());
+    LINGLONG_TRACE_SPAN("generate cache for " + ref.toString());
 
     auto layerItem = this->repo.getLayerItem(ref);
     if (!layerItem) {
@@ -9,6 +9,7 @@
 #include "linglong/utils/dbus/register.h"
 #include "linglong/utils/error/error.h"
 #include "linglong/utils/global/initialize.h"
+#include "linglong/utils/trace/span.h"
 
 #include <QDebug>
 #include <QUuid>
@@ -196,6 +197,7 @@ void PackageTask::Cancel() noexcept
 
 void PackageTask::run() noexcept
 {
+    utils::trace::Span span{ "package task " + m_refs.join(' ') };
     m_job(*this);
 }
 
@@ -18,8 +18,10 @@
 #include "linglong/package/reference.h"
 #include "linglong/package_manager/package_task.h"
 #include "linglong/repo/config.h"
+#include "linglong/repo/remote_reference_index.h"
 #include "linglong/utils/command/cmd.h"
 #include "linglong/utils/command/env.h"
+#include "linglong/utils/disk_space.h"
 #include "linglong/utils/error/error.h"
 #include "linglong/utils/file.h"
 #include "linglong/utils/finally/finally.h"
@@ -28,6 +30,7 @@
 #include "linglong/utils/packageinfo_handler.h"
 #include "linglong/utils/serialize/json.h"
 #include "linglong/utils/strings.h"
+#include "linglong/utils/trace/span.h"
 #include "linglong/utils/transaction.h"
 
 #include <gio/gio.h>
@@ -179,9 +182,9 @@ void progress_changed(OstreeAsyncProgress *progress, gpointer user_data)
     auto updateProgress = utils::finally::finally([&new_progress, data, &total] {
         LINGLONG_TRACE("update progress status")
 
+        // the error will be reported after pulling, the pull may be retried
         if (data->caught_error) {
-            data->taskContext->reportError(
-              LINGLONG_ERRV("Caught error during pulling data, waiting for outstanding task"));
+            qWarning() << "Caught error during pulling data, waiting for outstanding task";
             return;
         }
 
@@ -241,6 +244,88 @@ void progress_changed(OstreeAsyncProgress *progress, gpointer user_data)
     new_progress += (data->outstanding_writes > 0 ? (3.0 / data->outstanding_writes) : 3.0);
 }
 
+// errors which may disappear if we pull again later, e.g. the connection dropped
+bool isTransientPullError(const GError *err) noexcept
+{
+    if (err == nullptr) {
+        return false;
+    }
+
+    if (err->domain == G_RESOLVER_ERROR) {
+        return err->code == G_RESOLVER_ERROR_TEMPORARY_FAILURE;
+    }
+
+    if (err->domain != G_IO_ERROR) {
+        return false;
+    }
+
+    switch (err->code) {
+    case G_IO_ERROR_TIMED_OUT:
+    case G_IO_ERROR_CONNECTION_CLOSED:
+    case G_IO_ERROR_CONNECTION_REFUSED:
+    case G_IO_ERROR_BROKEN_PIPE:
+    case G_IO_ERROR_HOST_NOT_FOUND:
+    case G_IO_ERROR_HOST_UNREACHABLE:
+    case G_IO_ERROR_NETWORK_UNREACHABLE:
+    case G_IO_ERROR_PARTIAL_INPUT:
+        return true;
+    case G_IO_ERROR_FAILED:
+        // the curl fetcher of ostree reports transfer errors like this
+        return strstr(err->message, "While fetching") != nullptr;
+    default:
+        return false;
+    }
+}
+
+int pullRetries() noexcept
+{
+    constexpr auto defaultRetries = 3;
+    auto *retriesEnv = ::getenv("LINGLONG_PULL_RETRIES");
+    if (retriesEnv == nullptr) {
+        return defaultRetries;
+    }
+
+    try {
+        return std::max(std::stoi(retriesEnv), 0);
+    } catch (std::invalid_argument &e) {
+        qWarning() << "failed to parse LINGLONG_PULL_RETRIES[" << retriesEnv << "]:" << e.what();
+    } catch (std::out_of_range &e) {
+        qWarning() << "failed to parse LINGLONG_PULL_RETRIES[" << retriesEnv << "]:" << e.what();
+    }
+
+    return defaultRetries;
+}
+
+// wait before pulling again without blocking the event loop,
+// return false if the task is canceled meanwhile
+bool waitForRetry(std::chrono::seconds delay, GCancellable *cancellable) noexcept
+{
+    if (cancellable != nullptr && g_cancellable_is_cancelled(cancellable) == TRUE) {
+        return false;
+    }
+
+    QEventLoop loop;
+    QTimer::singleShot(delay, &loop, &QEventLoop::quit);
+    gulong handler{ 0 };
+    if (cancellable != nullptr) {
+        handler = g_cancellable_connect(cancellable,
+                                        G_CALLBACK(+[](GCancellable *, gpointer data) {
+                                            static_cast<QEventLoop *>(data)->quit();
+                                        }),
+                                        &loop,
+                                        nullptr);
+    }
+
+    loop.exec();
+
+    if (cancellable == nullptr) {
+        return true;
+    }
+
+    g_cancellable_disconnect(cancellable, handler);
+    return g_cancellable_is_cancelled(cancellable) == FALSE;
+}
+
 std::string ostreeRefFromLayerItem(const api::types::v1::RepositoryCacheLayersItem &layer)
 {
     std::string refspec = layer.info.channel + "/" + layer.info.id + "/" + layer.info.version + "/"
@@ -549,49 +634,6 @@ utils::error::Result<package::Reference> clearReferenceLocal(const linglong::rep
     return package::Reference::fromPackageInfo(foundRef->info);
 };
 
-std::optional<package::Reference> matchReference(const api::types::v1::PackageInfoV2 &record,
-                                                 const package::FuzzyReference &fuzzy,
-                                                 const std::string &module) noexcept
-{
-    auto recordStr = nlohmann::json(record).dump();
-    if (fuzzy.channel && fuzzy.channel->toStdString() != record.channel) {
-        return std::nullopt;
-    }
-    if (fuzzy.id.toStdString() != record.id) {
-        return std::nullopt;
-    }
-    auto version = package::Version::parse(QString::fromStdString(record.version));
-    if (!version) {
-        qWarning() << "Ignore invalid package record" << recordStr.c_str() << version.error();
-        return std::nullopt;
-    }
-    if (record.arch.empty()) {
-        qWarning() << "Ignore invalid package record";
-        return std::nullopt;
-    }
-    if (module == "binary") {
-        if (record.packageInfoV2Module != "binary" && record.packageInfoV2Module != "runtime") {
-            return std::nullopt;
-        }
-    } else {
-        if (record.packageInfoV2Module != module) {
-            return std::nullopt;
-        }
-    }
-    auto arch = package::Architecture::parse(record.arch[0]);
-    if (!arch) {
-        qWarning() << "Ignore invalid package record" << recordStr.c_str() << arch.error();
-        return std::nullopt;
-    }
-    auto channel = QString::fromStdString(record.channel);
-    auto currentRef = package::Reference::create(channel, fuzzy.id, *version, *arch);
-    if (!currentRef) {
-        qWarning() << "Ignore invalid package record" << recordStr.c_str() << currentRef.error();
-        return std::nullopt;
-    }
-    return *currentRef;
-}
-
 } // namespace
 
 utils::error::Result<void>
@@ -774,7 +816,7 @@ OSTreeRepo::OSTreeRepo(const QDir &path,
     this->repoDir = path;
 
     {
-        LINGLONG_TRACE("use linglong repo at " + path.absolutePath());
+        LINGLONG_TRACE_SPAN("use linglong repo at " + path.absolutePath());
 
         repoPath = g_file_new_for_path(this->ostreeRepoDir().absolutePath().toLocal8Bit());
         ostreeRepo = ostree_repo_new(repoPath);
@@ -947,6 +989,7 @@ OSTreeRepo::updateConfig(const api::types::v1::RepoConfigV2 &newCfg) noexcept
     const auto newRepo = getDefaultRepo(newCfg);
     this->m_clientFactory.setServer(QString::fromStdString(newRepo.url));
     this->cfg = newCfg;
+    this->clearRemoteSearchCache();
 
     return LINGLONG_OK;
 }
@@ -987,6 +1030,7 @@ utils::error::Result<void> OSTreeRepo::setConfig(const api::types::v1::RepoConfi
     const auto newRepo = getDefaultRepo(cfg);
     this->m_clientFactory.setServer(newRepo.url);
     this->cfg = cfg;
+    this->clearRemoteSearchCache();
 
     transaction.commit();
 
@@ -998,7 +1042,7 @@ OSTreeRepo::importLayerDir(const package::LayerDir &dir,
                            std::vector<std::filesystem::path> overlays,
                            const std::optional<std::string> &subRef) noexcept
 {
-    LINGLONG_TRACE("import layer dir");
+    LINGLONG_TRACE_SPAN("import layer dir");
 
     if (!dir.exists()) {
         return LINGLONG_ERR(QString("layer directory %1 not exists").arg(dir.absolutePath()));
@@ -1376,6 +1420,30 @@ OSTreeRepo::getCommitSize(const std::string &remote, const std::string &refStrin
 #endif
 }
 
+utils::error::Result<std::string>
+OSTreeRepo::getCommitContentChecksum(const std::string &commit) const noexcept
+{
+    LINGLONG_TRACE("get content checksum of commit " + QString::fromStdString(commit));
+
+    g_autoptr(GError) gErr = nullptr;
+    g_autoptr(GVariant) commitVariant = nullptr;
+    if (ostree_repo_load_variant(this->ostreeRepo.get(),
+                                 OSTREE_OBJECT_TYPE_COMMIT,
+                                 commit.c_str(),
+                                 &commitVariant,
+                                 &gErr)
+        == FALSE) {
+        return LINGLONG_ERR("ostree_repo_load_variant", gErr);
+    }
+
+    g_autofree gchar *checksum = ostree_commit_get_content_checksum(commitVariant);
+    if (checksum == nullptr) {
+        return LINGLONG_ERR("invalid commit " + QString::fromStdString(commit));
+    }
+
+    return std::string{ checksum };
+}
+
 void OSTreeRepo::pull(service::PackageTask &taskContext,
                       const package::Reference &reference,
                       const std::string &module,
@@ -1388,39 +1456,91 @@ void OSTreeRepo::pull(service::PackageTask &taskContext,
     if (repo) {
         pullRepo = repo.value();
     }
-    LINGLONG_TRACE(std::string{ "pull " + refString + " from " + pullRepo.name }.c_str());
+    LINGLONG_TRACE_SPAN(std::string{ "pull " + refString + " from " + pullRepo.name }.c_str());
 
     utils::Transaction transaction;
     auto *cancellable = taskContext.cancellable();
 
     ostreeUserData data{ .taskContext = &taskContext };
 
-    auto sizes = this->getCommitSize(pullRepo.alias.value_or(pullRepo.name), refString);
+    const auto remoteName = pullRepo.alias.value_or(pullRepo.name);
+    auto sizes = [this, &remoteName, &refString]() -> utils::error::Result<std::vector<guint64>> {
+        auto it = m_prefetchedCommitSizes.find(remoteName + ":" + refString);
+        if (it == m_prefetchedCommitSizes.end()) {
+            return this->getCommitSize(remoteName, refString);
+        }
+
+        auto prefetched = std::move(it->second);
+        m_prefetchedCommitSizes.erase(it);
+        return prefetched;
+    }();
     if (!sizes.has_value()) {
         LogD("get commit size error: {}", sizes.error().message());
     } else if (sizes->size() >= 3) {
         data.needed_archived = sizes->at(0);
         data.needed_unpacked = sizes->at(1);
         data.needed_objects = sizes->at(2);
+
+        // The archived objects are downloaded to the staging dir of the repo and written
+        // unpacked to the objects dir, the layers are checked out as hardlinks later.
+        // Fail before pulling instead of leaving a half pulled commit on a full disk.
+        auto ret = utils::checkDiskSpace(
+          { { this->repoDir.absolutePath().toStdString(),
+              data.needed_archived + data.needed_unpacked,
+              data.needed_objects } });
+        if (!ret) {
+            taskContext.reportError(LINGLONG_ERRV(ret));
+            return;
+        }
     }
 
-    g_autoptr(OstreeAsyncProgress) progress =
-      ostree_async_progress_new_and_connect(progress_changed, (void *)&data);
-    Q_ASSERT(progress != nullptr);
+    // Objects which have been pulled are kept in the repo, so pulling again after a network
+    // error only fetches the missing objects.
+    const auto retries = pullRetries();
+    auto pullWithRetry = [this, &pullRepo, &data, &taskContext, cancellable, retries](
+                           const std::string &ref,
+                           GError **gErr) -> gboolean {
+        for (int attempt = 0;; ++attempt) {
+            g_autoptr(OstreeAsyncProgress) progress =
+              ostree_async_progress_new_and_connect(progress_changed, (void *)&data);
+            Q_ASSERT(progress != nullptr);
+
+            auto builder = this->initOStreePullOptions(ref);
+            g_autoptr(GVariant) pull_options =
+              g_variant_ref_sink(g_variant_builder_end(&builder));
+            // 这里不能使用g_main_context_push_thread_default，因为会阻塞Qt的事件循环
+
+            auto status =
+              ostree_repo_pull_with_options(this->ostreeRepo.get(),
+                                            pullRepo.alias.value_or(pullRepo.name).c_str(),
+                                            pull_options,
+                                            progress,
+                                            cancellable,
+                                            gErr);
+            ostree_async_progress_finish(progress);
+            if (status == TRUE || attempt >= retries || !isTransientPullError(*gErr)) {
+                return status;
+            }
 
-    g_autoptr(GError) gErr = nullptr;
+            const auto delay = std::min(std::chrono::seconds{ 1LL << std::min(attempt, 5) },
+                                        std::chrono::seconds{ 30 });
+            qWarning() << "pull" << ref.c_str() << "failed:" << (*gErr)->message << "retry in"
+                       << delay.count() << "seconds";
+            taskContext.updateTask(static_cast<uint>(data.progress),
+                                   100,
+                                   QString{ "Network error, retry in %1 seconds" }.arg(
+                                     delay.count()));
+            if (!waitForRetry(delay, cancellable)) {
+                return status;
+            }
 
-    auto builder = this->initOStreePullOptions(refString);
-    g_autoptr(GVariant) pull_options = g_variant_ref_sink(g_variant_builder_end(&builder));
-    // 这里不能使用g_main_context_push_thread_default，因为会阻塞Qt的事件循环
+            g_clear_error(gErr);
+            data.caught_error = false;
+        }
+    };
 
-    auto status = ostree_repo_pull_with_options(this->ostreeRepo.get(),
-                                                pullRepo.alias.value_or(pullRepo.name).c_str(),
-                                                pull_options,
-                                                progress,
-                                                cancellable,
-                                                &gErr);
-    ostree_async_progress_finish(progress);
+    g_autoptr(GError) gErr = nullptr;
+    auto status = pullWithRetry(refString, &gErr);
     auto shouldFallback = false;
     if (status == FALSE) {
         // gErr->code is 0, so we compare string here.
@@ -1433,26 +1553,13 @@ void OSTreeRepo::pull(service::PackageTask &taskContext,
     }
     // Note: this fallback is only for binary to runtime
     if (shouldFallback && (module == "binary" || module == "runtime")) {
-        g_autoptr(OstreeAsyncProgress) progress =
-          ostree_async_progress_new_and_connect(progress_changed, (void *)&data);
-        Q_ASSERT(progress != nullptr);
         // fallback to old ref
         refString = ostreeSpecFromReference(reference, std::nullopt, module);
         qWarning() << "fallback to module runtime, pull " << QString::fromStdString(refString);
 
         g_clear_error(&gErr);
 
-        GVariantBuilder builder = this->initOStreePullOptions(refString);
-
-        g_autoptr(GVariant) pull_options = g_variant_ref_sink(g_variant_builder_end(&builder));
-
-        status = ostree_repo_pull_with_options(this->ostreeRepo.get(),
-                                               pullRepo.alias.value_or(pullRepo.name).c_str(),
-                                               pull_options,
-                                               progress,
-                                               cancellable,
-                                               &gErr);
-        ostree_async_progress_finish(progress);
+        status = pullWithRetry(refString, &gErr);
         if (status == FALSE) {
             taskContext.reportError(LINGLONG_ERRV("ostree_repo_pull", gErr));
             return;
@@ -1501,6 +1608,24 @@ void OSTreeRepo::pull(service::PackageTask &taskContext,
     transaction.commit();
 }
 
+void OSTreeRepo::prefetch(const package::Reference &reference,
+                          const std::string &module,
+                          const api::types::v1::Repo &repo) noexcept
+{
+    auto refString = ostreeSpecFromReferenceV2(reference, std::nullopt, module);
+    const auto remoteName = repo.alias.value_or(repo.name);
+
+    // getCommitSize pulls the commit object, the sizes are kept for the next pull
+    auto sizes = this->getCommitSize(remoteName, refString);
+    if (!sizes) {
+        qDebug() << "prefetch" << refString.c_str() << "failed:" << sizes.error().message();
+        return;
+    }
+
+    m_prefetchedCommitSizes.insert_or_assign(remoteName + ":" + refString,
+                                             std::move(sizes).value());
+}
+
 utils::error::Result<package::Reference>
 OSTreeRepo::clearReference(const package::FuzzyReference &fuzzy,
                            const clearReferenceOption &opts,
@@ -1512,7 +1637,7 @@ OSTreeRepo::clearReference(const package::FuzzyReference &fuzzy,
     utils::error::Result<package::Reference> reference = LINGLONG_ERR("reference not exists");
 
     if (!opts.forceRemote) {
-        reference = clearReferenceLocal(*cache, fuzzy, opts.semanticMatching);
+        reference = this->clearReferenceLocalMemoized(fuzzy, opts.semanticMatching);
         if (reference) {
             return reference;
         }
@@ -1542,10 +1667,7 @@ OSTreeRepo::clearReference(const package::FuzzyReference &fuzzy,
     }
 
     std::optional<package::Version> fuzzyVersion;
-    auto list = std::move(listRet).value();
     if (fuzzy.version) {
-        list = package::Version::filterByFuzzyVersion(list, *fuzzy.version);
-
         auto fuzzyVerRet = linglong::package::Version::parse(*fuzzy.version);
         if (!fuzzyVerRet) {
             return LINGLONG_ERR(fuzzyVerRet);
@@ -1553,33 +1675,10 @@ OSTreeRepo::clearReference(const package::FuzzyReference &fuzzy,
         fuzzyVersion = std::move(fuzzyVerRet).value();
     }
 
-    for (const auto &record : list) {
-        auto currentRefRet = matchReference(record, fuzzy, module);
-        if (!currentRefRet) {
-            continue;
-        }
-
-        if (fuzzyVersion) {
-            // 语义化匹配最新的版本
-            if (opts.semanticMatching) {
-                if (!reference || currentRefRet->version > reference->version) {
-                    reference = *currentRefRet;
-                }
-                continue;
-            }
-
-            // 精确匹配版本
-            if (currentRefRet->version == *fuzzyVersion) {
-                reference = *currentRefRet;
-                break;
-            }
-            continue;
-        }
-
-        // 匹配最新版本
-        if (!reference || currentRefRet->version > reference->version) {
-            reference = *currentRefRet;
-        }
+    // 精确匹配版本、语义化匹配最新的版本或者匹配最新版本
+    const RemoteReferenceIndex index(*listRet);
+    if (auto ref = index.find(fuzzy, module, fuzzyVersion, opts.semanticMatching); ref) {
+        reference = std::move(ref).value();
     }
 
     if (!reference) {
@@ -1591,6 +1690,36 @@ OSTreeRepo::clearReference(const package::FuzzyReference &fuzzy,
     return reference;
 }
 
+utils::error::Result<package::Reference>
+OSTreeRepo::clearReferenceLocalMemoized(const package::FuzzyReference &fuzzy,
+                                        bool semanticMatching) const noexcept
+{
+    LINGLONG_TRACE("clear fuzzy reference locally " + fuzzy.toString());
+
+    // the generation of repo cache changes on every modification, so outdated results
+    // will never be hit and are evicted by the LRU cache eventually
+    LocalReferenceKey key{ fuzzy.id.toStdString(),
+                           fuzzy.version.value_or(QString{}).toStdString(),
+                           fuzzy.arch ? fuzzy.arch->toStdString() : std::string{},
+                           semanticMatching,
+                           this->cache->generation() };
+    {
+        std::lock_guard<std::mutex> lock(m_localReferenceMutex);
+        if (auto ref = m_localReferenceMemo.get(key); ref) {
+            return std::move(ref).value();
+        }
+    }
+
+    auto ref = clearReferenceLocal(*this->cache, fuzzy, semanticMatching);
+    if (!ref) {
+        return LINGLONG_ERR(ref);
+    }
+
+    std::lock_guard<std::mutex> lock(m_localReferenceMutex);
+    m_localReferenceMemo.put(key, *ref);
+    return ref;
+}
+
 utils::error::Result<linglong::package::ReferenceWithRepo>
 OSTreeRepo::getRemoteReferenceByPriority(const package::FuzzyReference &fuzzy,
                                          const getRemoteReferenceByPriorityOption &opts,
@@ -1738,6 +1867,46 @@ OSTreeRepo::listRemote(const package::FuzzyReference &fuzzyRef,
 {
     LINGLONG_TRACE("list remote references");
 
+    auto defaultArch = package::Architecture::currentCPUArchitecture();
+    if (!defaultArch) {
+        return LINGLONG_ERR(defaultArch);
+    }
+
+    const auto remote = repo.value_or(getDefaultRepo(this->cfg));
+    const RemoteSearchKey key{
+        .repo = remote.name,
+        .url = remote.url,
+        .id = fuzzyRef.id.toStdString(),
+        .channel = fuzzyRef.channel.value_or(QString{}).toStdString(),
+        .version = fuzzyRef.version.value_or(QString{}).toStdString(),
+        .arch = fuzzyRef.arch.value_or(*defaultArch).toStdString(),
+    };
+    if (auto cached = m_remoteSearchCache.find(key); cached) {
+        qDebug() << "use cached search result of" << fuzzyRef.toString() << "from"
+                 << remote.name.c_str();
+        return std::move(cached).value();
+    }
+
+    auto result = this->searchRemote(fuzzyRef, repo);
+    if (!result) {
+        return LINGLONG_ERR(result);
+    }
+
+    m_remoteSearchCache.insert(key, *result);
+    return result;
+}
+
+void OSTreeRepo::clearRemoteSearchCache() noexcept
+{
+    m_remoteSearchCache.clear();
+}
+
+utils::error::Result<std::vector<api::types::v1::PackageInfoV2>>
+OSTreeRepo::searchRemote(const package::FuzzyReference &fuzzyRef,
+                         const std::optional<api::types::v1::Repo> &repo) const noexcept
+{
+    LINGLONG_TRACE("search remote references");
+
     if (repo) {
         m_clientFactory.setServer(repo->url);
     }
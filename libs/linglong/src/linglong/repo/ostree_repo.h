@@ -14,14 +14,19 @@
 #include "linglong/package/reference.h"
 #include "linglong/package_manager/package_task.h"
 #include "linglong/repo/client_factory.h"
+#include "linglong/repo/remote_search_cache.h"
 #include "linglong/repo/repo_cache.h"
 #include "linglong/utils/error/error.h"
+#include "linglong/utils/lru_cache.h"
 
 #include <ostree.h>
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace linglong::repo {
@@ -86,6 +91,11 @@ public:
               const package::Reference &reference,
               const std::string &module = "binary",
               const std::optional<api::types::v1::Repo> &repo = std::nullopt) noexcept;
+    // Fetch the commit metadata of reference in advance, e.g. while waiting for the user to
+    // confirm an upgrade, the next pull of the same reference reuses it.
+    void prefetch(const package::Reference &reference,
+                  const std::string &module,
+                  const api::types::v1::Repo &repo) noexcept;
 
     [[nodiscard]] utils::error::Result<package::Reference>
     clearReference(const package::FuzzyReference &fuzzy,
@@ -103,6 +113,8 @@ public:
     utils::error::Result<std::vector<api::types::v1::PackageInfoV2>>
     listRemote(const package::FuzzyReference &fuzzyRef,
                const std::optional<api::types::v1::Repo> &repo = std::nullopt) const noexcept;
+    // drop the cached results of listRemote, the next query will reach the remote repo
+    void clearRemoteSearchCache() noexcept;
 
     utils::error::Result<std::vector<api::types::v1::RepositoryCacheLayersItem>>
     listLayerItem() const noexcept;
@@ -174,7 +186,21 @@ private:
     QDir repoDir;
     std::unique_ptr<linglong::repo::RepoCache> cache{ nullptr };
     ClientFactory &m_clientFactory;
+    mutable RemoteSearchCache m_remoteSearchCache{ RemoteSearchCache::ttlFromEnv() };
+    // commit sizes fetched by prefetch, keyed by "remote:refspec"
+    std::map<std::string, std::vector<guint64>> m_prefetchedCommitSizes;
+    // (id, version, arch, semanticMatching, generation of repo cache)
+    using LocalReferenceKey = std::tuple<std::string, std::string, std::string, bool, uint64_t>;
+    mutable std::mutex m_localReferenceMutex;
+    mutable utils::LRUCache<LocalReferenceKey, package::Reference> m_localReferenceMemo{ 256 };
 
+    [[nodiscard]] utils::error::Result<package::Reference>
+    clearReferenceLocalMemoized(const package::FuzzyReference &fuzzy,
+                                bool semanticMatching) const noexcept;
+
+    utils::error::Result<std::vector<api::types::v1::PackageInfoV2>>
+    searchRemote(const package::FuzzyReference &fuzzyRef,
+                 const std::optional<api::types::v1::Repo> &repo) const noexcept;
     utils::error::Result<void> updateConfig(const api::types::v1::RepoConfigV2 &newCfg) noexcept;
     QDir ostreeRepoDir() const noexcept;
     [[nodiscard]] utils::error::Result<QDir>
@@ -197,6 +223,10 @@ private:
     utils::error::Result<void> exportAllEntries() noexcept;
     utils::error::Result<std::vector<guint64>> getCommitSize(const std::string &remote,
                                                              const std::string &refString) noexcept;
+    // checksum of the tree and its metadata of a commit, commits with the same content have the
+    // same content checksum even if they are committed at different times
+    [[nodiscard]] utils::error::Result<std::string>
+    getCommitContentChecksum(const std::string &commit) const noexcept;
     GVariantBuilder initOStreePullOptions(const std::string &ref) noexcept;
 
 protected:
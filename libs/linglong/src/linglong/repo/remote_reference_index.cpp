@@ -0,0 +1,137 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "remote_reference_index.h"
+
+#include "linglong/package/architecture.h"
+
+#include <nlohmann/json.hpp>
+
+#include <QDebug>
+
+#include <algorithm>
+
+namespace linglong::repo {
+
+RemoteReferenceIndex::RemoteReferenceIndex(
+  const std::vector<api::types::v1::PackageInfoV2> &records) noexcept
+{
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        const auto &record = records[i];
+        if (record.arch.empty()) {
+            qWarning() << "Ignore invalid package record";
+            continue;
+        }
+
+        auto version = package::Version::tryParse(record.version);
+        if (!version) {
+            qWarning() << "Ignore invalid package record" << nlohmann::json(record).dump().c_str()
+                       << "invalid version";
+            continue;
+        }
+
+        auto arch = package::Architecture::parse(record.arch[0]);
+        if (!arch) {
+            qWarning() << "Ignore invalid package record" << nlohmann::json(record).dump().c_str()
+                       << arch.error();
+            continue;
+        }
+
+        auto ref = package::Reference::create(QString::fromStdString(record.channel),
+                                              QString::fromStdString(record.id),
+                                              *version,
+                                              *arch);
+        if (!ref) {
+            qWarning() << "Ignore invalid package record" << nlohmann::json(record).dump().c_str()
+                       << ref.error();
+            continue;
+        }
+
+        this->groups[Key{ record.id, record.arch[0], record.channel, record.packageInfoV2Module }]
+          .push_back(Entry{ std::move(ref).value(), i });
+        ++this->count;
+    }
+
+    // keep the order of the search response for the same version
+    for (auto &[key, entries] : this->groups) {
+        std::stable_sort(entries.begin(), entries.end(), [](const Entry &lhs, const Entry &rhs) {
+            return lhs.reference.version > rhs.reference.version;
+        });
+    }
+}
+
+std::optional<package::Reference>
+RemoteReferenceIndex::find(const package::FuzzyReference &fuzzy,
+                           const std::string &module,
+                           const std::optional<package::Version> &version,
+                           bool semanticMatching) const noexcept
+{
+    const auto id = fuzzy.id.toStdString();
+    const auto fuzzyVersion = fuzzy.version.value_or(version ? version->toString() : QString{});
+
+    const Entry *found{ nullptr };
+    auto select = [&found](const Entry &entry) {
+        if (found == nullptr || entry.reference.version > found->reference.version
+            || (entry.reference.version == found->reference.version
+                && entry.position < found->position)) {
+            found = &entry;
+        }
+    };
+
+    for (auto it = this->groups.lower_bound(Key{ id, {}, {}, {} });
+         it != this->groups.end() && it->first.id == id;
+         ++it) {
+        const auto &[key, entries] = *it;
+        if (fuzzy.channel && fuzzy.channel->toStdString() != key.channel) {
+            continue;
+        }
+        if (module == "binary") {
+            if (key.module != "binary" && key.module != "runtime") {
+                continue;
+            }
+        } else if (key.module != module) {
+            continue;
+        }
+
+        if (!version) {
+            select(entries.front());
+            continue;
+        }
+
+        if (semanticMatching) {
+            // entries are sorted, the first compatible one is the latest
+            auto entry =
+              std::find_if(entries.begin(), entries.end(), [&fuzzyVersion](const Entry &e) {
+                  return e.reference.version.semanticMatch(fuzzyVersion);
+              });
+            if (entry != entries.end()) {
+                select(*entry);
+            }
+            continue;
+        }
+
+        auto entry = std::lower_bound(entries.begin(),
+                                      entries.end(),
+                                      *version,
+                                      [](const Entry &e, const package::Version &v) {
+                                          return e.reference.version > v;
+                                      });
+        for (; entry != entries.end() && entry->reference.version == *version; ++entry) {
+            if (entry->reference.version.semanticMatch(fuzzyVersion)) {
+                select(*entry);
+                break;
+            }
+        }
+    }
+
+    if (found == nullptr) {
+        return std::nullopt;
+    }
+
+    return found->reference;
+}
+
+} // namespace linglong::repo
@@ -0,0 +1,69 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "linglong/api/types/v1/PackageInfoV2.hpp"
+#include "linglong/package/fuzzy_reference.h"
+#include "linglong/package/reference.h"
+#include "linglong/package/version.h"
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace linglong::repo {
+
+// RemoteReferenceIndex parses the records returned by a remote search once and groups
+// them by (id, arch, channel, module), every group is sorted by version in descending order.
+class RemoteReferenceIndex
+{
+public:
+    explicit RemoteReferenceIndex(
+      const std::vector<api::types::v1::PackageInfoV2> &records) noexcept;
+
+    // Find the reference matching fuzzy and module, 'binary' module matches 'runtime' too.
+    // If version is set, the reference with exactly this version is returned, or the
+    // latest one compatible with it when semanticMatching is true.
+    // Otherwise the latest reference is returned.
+    // Records with the same version are resolved in the order of the search response.
+    [[nodiscard]] std::optional<package::Reference>
+    find(const package::FuzzyReference &fuzzy,
+         const std::string &module,
+         const std::optional<package::Version> &version,
+         bool semanticMatching) const noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept { return this->count; }
+
+private:
+    struct Key
+    {
+        std::string id;
+        std::string arch;
+        std::string channel;
+        std::string module;
+
+        bool operator<(const Key &other) const noexcept
+        {
+            return std::tie(id, arch, channel, module)
+              < std::tie(other.id, other.arch, other.channel, other.module);
+        }
+    };
+
+    struct Entry
+    {
+        package::Reference reference;
+        std::size_t position; // position in the search response
+    };
+
+    std::map<Key, std::vector<Entry>> groups;
+    std::size_t count{ 0 };
+};
+
+} // namespace linglong::repo
@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "remote_search_cache.h"
+
+#include <QDebug>
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+
+namespace linglong::repo {
+
+RemoteSearchCache::RemoteSearchCache(std::chrono::seconds ttl, std::size_t capacity) noexcept
+    : ttl(ttl)
+    , capacity(capacity)
+{
+}
+
+std::chrono::seconds RemoteSearchCache::ttlFromEnv() noexcept
+{
+    auto *ttlEnv = ::getenv("LINGLONG_SEARCH_CACHE_TTL");
+    if (ttlEnv == nullptr) {
+        return DefaultTTL;
+    }
+
+    try {
+        return std::chrono::seconds{ std::max(std::stoi(ttlEnv), 0) };
+    } catch (std::invalid_argument &e) {
+        qWarning() << "failed to parse LINGLONG_SEARCH_CACHE_TTL[" << ttlEnv << "]:" << e.what();
+    } catch (std::out_of_range &e) {
+        qWarning() << "failed to parse LINGLONG_SEARCH_CACHE_TTL[" << ttlEnv << "]:" << e.what();
+    }
+
+    return DefaultTTL;
+}
+
+std::optional<std::vector<api::types::v1::PackageInfoV2>>
+RemoteSearchCache::find(const RemoteSearchKey &key, Clock::time_point now) const noexcept
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    auto it = this->entries.find(key);
+    if (it == this->entries.end() || now - it->second.time >= this->ttl) {
+        return std::nullopt;
+    }
+
+    return it->second.result;
+}
+
+void RemoteSearchCache::insert(const RemoteSearchKey &key,
+                               std::vector<api::types::v1::PackageInfoV2> result,
+                               Clock::time_point now) noexcept
+{
+    if (this->ttl.count() == 0 || this->capacity == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    // drop expired entries first, then the oldest one if the cache is still full
+    for (auto it = this->entries.begin(); it != this->entries.end();) {
+        if (now - it->second.time >= this->ttl) {
+            it = this->entries.erase(it);
+            continue;
+        }
+        ++it;
+    }
+
+    if (this->entries.size() >= this->capacity && this->entries.find(key) == this->entries.end()) {
+        auto oldest = std::min_element(this->entries.begin(),
+                                       this->entries.end(),
+                                       [](const auto &lhs, const auto &rhs) {
+                                           return lhs.second.time < rhs.second.time;
+                                       });
+        this->entries.erase(oldest);
+    }
+
+    this->entries.insert_or_assign(key, Entry{ now, std::move(result) });
+}
+
+void RemoteSearchCache::clear() noexcept
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->entries.clear();
+}
+
+std::size_t RemoteSearchCache::size() const noexcept
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->entries.size();
+}
+
+} // namespace linglong::repo
@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "linglong/api/types/v1/PackageInfoV2.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace linglong::repo {
+
+struct RemoteSearchKey
+{
+    std::string repo; // name of the remote repo
+    std::string url;  // url of the remote repo
+    std::string id;
+    std::string channel;
+    std::string version;
+    std::string arch;
+
+    bool operator<(const RemoteSearchKey &other) const noexcept
+    {
+        return std::tie(repo, url, id, channel, version, arch)
+          < std::tie(other.repo, other.url, other.id, other.channel, other.version, other.arch);
+    }
+};
+
+// RemoteSearchCache keeps the result of remote searchApp requests for a short time,
+// so identical queries made by different clients of the package manager in one
+// session (e.g. `ll-cli search` followed by `ll-cli install`) reach the server only once.
+class RemoteSearchCache
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::seconds DefaultTTL{ 60 };
+    static constexpr std::size_t DefaultCapacity{ 128 };
+
+    explicit RemoteSearchCache(std::chrono::seconds ttl = DefaultTTL,
+                               std::size_t capacity = DefaultCapacity) noexcept;
+
+    // TTL used by the package manager, LINGLONG_SEARCH_CACHE_TTL (in seconds) overrides
+    // the default, 0 disables the cache.
+    static std::chrono::seconds ttlFromEnv() noexcept;
+
+    [[nodiscard]] std::optional<std::vector<api::types::v1::PackageInfoV2>>
+    find(const RemoteSearchKey &key, Clock::time_point now = Clock::now()) const noexcept;
+    void insert(const RemoteSearchKey &key,
+                std::vector<api::types::v1::PackageInfoV2> result,
+                Clock::time_point now = Clock::now()) noexcept;
+    void clear() noexcept;
+    [[nodiscard]] std::size_t size() const noexcept;
+
+private:
+    struct Entry
+    {
+        Clock::time_point time;
+        std::vector<api::types::v1::PackageInfoV2> result;
+    };
+
+    std::chrono::seconds ttl;
+    std::size_t capacity;
+    mutable std::mutex mutex;
+    std::map<RemoteSearchKey, Entry> entries;
+};
+
+} // namespace linglong::repo
@@ -10,18 +10,26 @@
 #include "linglong/package/version.h"
 #include "linglong/utils/packageinfo_handler.h"
 #include "linglong/utils/serialize/json.h"
+#include "linglong/utils/trace/span.h"
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
 
 namespace linglong::repo {
 
+uint64_t RepoCache::nextGeneration() noexcept
+{
+    static std::atomic<uint64_t> generation{ 0 };
+    return ++generation;
+}
+
 utils::error::Result<std::unique_ptr<RepoCache>>
 RepoCache::create(const std::filesystem::path &cacheFile,
                   const api::types::v1::RepoConfigV2 &repoConfig,
                   OstreeRepo &repo)
 {
-    LINGLONG_TRACE("load from RepoCache");
+    LINGLONG_TRACE_SPAN("load from RepoCache");
 
     struct enableMaker : public RepoCache
     {
@@ -79,6 +87,7 @@ utils::error::Result<void> RepoCache::rebuildCache(const api::types::v1::RepoCon
 {
     LINGLONG_TRACE("rebuild repo cache");
 
+    this->gen = nextGeneration();
     this->cache.llVersion = LINGLONG_VERSION;
     this->cache.config = repoConfig;
     this->cache.version = cacheFileVersion;
@@ -160,6 +169,7 @@ RepoCache::addLayerItem(const api::types::v1::RepositoryCacheLayersItem &item)
     }
 
     cache.layers.emplace_back(item);
+    this->gen = nextGeneration();
     auto ret = writeToDisk();
     if (!ret) {
         return LINGLONG_ERR(ret);
@@ -172,6 +182,9 @@ utils::error::Result<std::vector<api::types::v1::RepositoryCacheLayersItem>::ite
 RepoCache::findMatchingItem(const api::types::v1::RepositoryCacheLayersItem &item) noexcept
 {
     LINGLONG_TRACE("find matching item");
+
+    // the returned iterator allows callers to modify the item
+    this->gen = nextGeneration();
     auto it = std::find_if(
       cache.layers.begin(),
       cache.layers.end(),
@@ -202,6 +215,7 @@ RepoCache::deleteLayerItem(const api::types::v1::RepositoryCacheLayersItem &item
     }
 
     cache.layers.erase(*it);
+    this->gen = nextGeneration();
     auto ret = writeToDisk();
     if (!ret) {
         return LINGLONG_ERR(ret);
@@ -274,12 +288,12 @@ RepoCache::queryLayerItem(const repoCacheQuery &query) const noexcept
     }
 
     std::sort(layers_view.begin(), layers_view.end(), [](itemRef lhs, itemRef rhs) {
-        auto lhsVersion = linglong::package::Version::parse(lhs.get().info.version.c_str());
+        auto lhsVersion = linglong::package::Version::tryParse(lhs.get().info.version);
         if (!lhsVersion) {
             qCritical() << "Failed to parse lhs version: " << lhs.get().info.version.c_str();
             return false;
         }
-        auto rhsVersion = linglong::package::Version::parse(rhs.get().info.version.c_str());
+        auto rhsVersion = linglong::package::Version::tryParse(rhs.get().info.version);
         if (!rhsVersion) {
             qCritical() << "Failed to parse rhs version: " << rhs.get().info.version.c_str();
             return false;
@@ -295,6 +309,7 @@ utils::error::Result<void> RepoCache::updateMergedItems(
 {
     LINGLONG_TRACE("update merged items");
     cache.merged = items;
+    this->gen = nextGeneration();
     auto ret = writeToDisk();
     if (!ret) {
         return LINGLONG_ERR(ret);
@@ -14,6 +14,7 @@
 
 #include <ostree.h>
 
+#include <cstdint>
 #include <filesystem>
 
 namespace linglong::repo {
@@ -88,10 +89,16 @@ public:
     findMatchingItem(const api::types::v1::RepositoryCacheLayersItem &item) noexcept;
     utils::error::Result<void> writeToDisk();
 
+    // generation changes every time the cache may be modified, values are never reused by
+    // other RepoCache instances, so it can be used to key results derived from the cache
+    [[nodiscard]] uint64_t generation() const noexcept { return this->gen; }
+
 private:
     RepoCache() = default;
     static constexpr auto cacheFileVersion = "2";
+    static uint64_t nextGeneration() noexcept;
     api::types::v1::RepositoryCache cache;
     std::filesystem::path cacheFile;
+    uint64_t gen{ nextGeneration() };
 };
 } // namespace linglong::repo
@@ -10,6 +10,7 @@
 #include "linglong/utils/bash_command_helper.h"
 #include "linglong/utils/bash_quote.h"
 #include "linglong/utils/finally/finally.h"
+#include "linglong/utils/trace/span.h"
 #include "ocppi/runtime/RunOption.hpp"
 #include "ocppi/runtime/config/types/Generators.hpp"
 
@@ -194,6 +195,7 @@ utils::error::Result<void> Container::run(const ocppi::runtime::config::types::P
     auto originalArgs =
       this->cfg.process->args.value_or(std::vector<std::string>{ "echo", "noting to run" });
 
+    utils::trace::Span writeSpan{ "write bundle" };
     auto entrypoint = bundle / "entrypoint.sh";
     {
         std::ofstream ofs(entrypoint);
@@ -257,11 +259,15 @@ utils::error::Result<void> Container::run(const ocppi::runtime::config::types::P
         ofs << nlohmann::json(this->cfg);
         ofs.close();
     }
+    writeSpan.end();
     qDebug() << "run container in " << bundle.c_str();
     // 禁用crun自己创建cgroup，便于AM识别和管理玲珑应用
     opt.GlobalOption::extra.emplace_back("--cgroup-manager=disabled");
 
+    // crun doesn't return until the container exits, the span covers the whole lifetime of it
+    utils::trace::Span runSpan{ "crun run" };
     auto result = this->cli.run(this->id, bundle, opt);
+    runSpan.end();
 
     if (!result) {
         return LINGLONG_ERR("cli run", result);
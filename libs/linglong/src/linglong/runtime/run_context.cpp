@@ -8,6 +8,7 @@
 #include "linglong/extension/extension.h"
 #include "linglong/runtime/container_builder.h"
 #include "linglong/utils/log/log.h"
+#include "linglong/utils/trace/span.h"
 
 namespace linglong::runtime {
 
@@ -78,7 +79,7 @@ RunContext::~RunContext()
 utils::error::Result<void> RunContext::resolve(const linglong::package::Reference &runnable,
                                                const ResolveOptions &options)
 {
-    LINGLONG_TRACE("resolve RunContext from runnable " + runnable.toString());
+    LINGLONG_TRACE_SPAN("resolve RunContext from runnable " + runnable.toString());
 
     containerID = runtime::genContainerID(runnable);
 
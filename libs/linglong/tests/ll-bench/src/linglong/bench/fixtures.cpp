@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "linglong/bench/fixtures.h"
+
+#include <fmt/format.h>
+
+#include <fstream>
+
+namespace linglong::bench {
+
+std::vector<std::string> makeVersions(std::size_t count)
+{
+    std::vector<std::string> versions;
+    versions.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto major = i / 1000 % 10;
+        auto minor = i / 100 % 10;
+        auto patch = i % 100;
+        switch (i % 4) {
+        case 0:
+            // most of the packages in the wild still use the four parts version
+            versions.emplace_back(fmt::format("{}.{}.{}.{}", major, minor, patch, i % 7));
+            break;
+        case 1:
+            versions.emplace_back(fmt::format("{}.{}.{}", major, minor, patch));
+            break;
+        case 2:
+            versions.emplace_back(fmt::format("{}.{}.{}-beta.{}", major, minor, patch, i % 5));
+            break;
+        default:
+            versions.emplace_back(
+              fmt::format("{}.{}.{}+security.{}", major, minor, patch, i % 3 + 1));
+            break;
+        }
+    }
+
+    return versions;
+}
+
+api::types::v1::RepositoryCache makeRepositoryCache(std::size_t layers)
+{
+    constexpr std::size_t versionsPerPackage = 10;
+    const auto versions = makeVersions(versionsPerPackage);
+
+    api::types::v1::RepositoryCache cache;
+    api::types::v1::Repo repo;
+    repo.name = "stable";
+    repo.url = "https://mirror-repo-linglong.deepin.com";
+    repo.priority = 0;
+    cache.config.defaultRepo = repo.name;
+    cache.config.repos.emplace_back(std::move(repo));
+    cache.config.version = 2;
+
+    cache.layers.reserve(layers);
+    for (std::size_t i = 0; i < layers; ++i) {
+        auto package = i / (versionsPerPackage * 2);
+
+        api::types::v1::RepositoryCacheLayersItem item;
+        item.commit = fmt::format("{:064x}", i);
+        item.repo = "stable";
+        item.info.arch = { "x86_64" };
+        item.info.base = "main:org.deepin.base/23.1.0.0/x86_64";
+        item.info.channel = "main";
+        item.info.id = fmt::format("org.deepin.bench.app{:04}", package);
+        item.info.name = fmt::format("app{:04}", package);
+        item.info.kind = "app";
+        item.info.packageInfoV2Module = i % 2 == 0 ? "binary" : "develop";
+        item.info.runtime = "main:org.deepin.runtime.dtk/23.1.0.0/x86_64";
+        item.info.schemaVersion = "1.0";
+        item.info.size = static_cast<int64_t>(i * 4096);
+        item.info.version = versions[i / 2 % versionsPerPackage];
+        cache.layers.emplace_back(std::move(item));
+    }
+
+    return cache;
+}
+
+void makeLayerTree(const std::filesystem::path &root, std::size_t entries)
+{
+    for (const auto *dir : { "etc", "opt", "usr/bin", "usr/share", "var/lib" }) {
+        std::filesystem::create_directories(root / dir);
+    }
+
+    for (std::size_t i = 0; i < entries; ++i) {
+        std::filesystem::create_directories(root / "usr/lib/bench" / std::to_string(i));
+    }
+
+    // the entries which are bound again when the self adjusting mount fixes /usr/share
+    for (std::size_t i = 0; i < 50; ++i) {
+        std::filesystem::create_directories(root / "usr/share" / fmt::format("data{}", i));
+    }
+}
+
+std::vector<ocppi::runtime::config::types::Mount> makeMounts(const std::filesystem::path &source,
+                                                             std::size_t count)
+{
+    std::vector<ocppi::runtime::config::types::Mount> mounts;
+    mounts.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto destination = i % 2 == 0 ? fmt::format("/usr/lib/bench/{}", i / 2)
+                                      : fmt::format("/usr/share/bench/{}/{}", i % 10, i);
+        mounts.emplace_back(ocppi::runtime::config::types::Mount{
+          .destination = std::move(destination),
+          .options = std::vector<std::string>{ "rbind", i % 3 == 0 ? "rw" : "ro" },
+          .source = (source / std::to_string(i)).string(),
+          .type = "bind",
+        });
+    }
+
+    return mounts;
+}
+
+void makeFileTree(const std::filesystem::path &root, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        auto dir = root / fmt::format("{:03}", i / 10000) / fmt::format("{:02}", i / 100 % 100);
+        if (i % 100 == 0) {
+            std::filesystem::create_directories(dir);
+        }
+
+        // some of the files are named like the libraries in the blacklist
+        auto name = i % 100 == 99 ? std::string{ "libGL.so.1" } : fmt::format("file{:02}", i % 100);
+        if (i % 50 == 1) {
+            std::filesystem::create_symlink(fmt::format("file{:02}", i % 100 - 1), dir / name);
+            continue;
+        }
+
+        std::ofstream(dir / name) << i;
+    }
+}
+
+} // namespace linglong::bench
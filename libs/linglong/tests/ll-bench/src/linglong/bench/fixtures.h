@@ -0,0 +1,40 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "linglong/api/types/v1/RepositoryCache.hpp"
+#include "ocppi/runtime/config/types/Mount.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Synthetic inputs of the benchmarks, they are generated deterministically so the results of
+// different commits are comparable.
+
+namespace linglong::bench {
+
+// the versions of a package in the synthetic repository, mixing all kinds of version strings
+std::vector<std::string> makeVersions(std::size_t count);
+
+// `layers` layers of 10 versions and 2 modules per package, like a long used local repository
+api::types::v1::RepositoryCache makeRepositoryCache(std::size_t layers);
+
+// a layer tree with `entries` directories under /usr/lib/bench, the mounts of makeMounts() bind
+// onto them
+void makeLayerTree(const std::filesystem::path &root, std::size_t entries);
+
+// `count` bind mounts from `source`, half of them point to paths which don't exist in the layer
+// tree, so the self adjusting mount has to fix them
+std::vector<ocppi::runtime::config::types::Mount> makeMounts(const std::filesystem::path &source,
+                                                             std::size_t count);
+
+// `count` regular files and a few symlinks under `root`, 100 entries per directory
+void makeFileTree(const std::filesystem::path &root, std::size_t count);
+
+} // namespace linglong::bench
@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "linglong/bench/fixtures.h"
+#include "linglong/oci-cfg-generators/container_cfg_builder.h"
+
+#include <QTemporaryDir>
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <vector>
+
+using namespace linglong;
+
+namespace {
+
+struct LayerFixture
+{
+    QTemporaryDir dir;
+    std::filesystem::path basePath;
+    std::filesystem::path bundlePath;
+    std::vector<ocppi::runtime::config::types::Mount> mounts;
+};
+
+const LayerFixture &fixture(int64_t count)
+{
+    static std::map<int64_t, std::unique_ptr<LayerFixture>> fixtures;
+    auto &ret = fixtures[count];
+    if (ret) {
+        return *ret;
+    }
+
+    ret = std::make_unique<LayerFixture>();
+    std::filesystem::path root = ret->dir.path().toStdString();
+    ret->basePath = root / "base" / "files";
+    ret->bundlePath = root / "bundle";
+    bench::makeLayerTree(ret->basePath, static_cast<std::size_t>(count) / 2);
+    // the environment variables are written to the bundle
+    std::filesystem::create_directories(ret->bundlePath);
+    ret->mounts = bench::makeMounts(root / "extensions", static_cast<std::size_t>(count));
+    return *ret;
+}
+
+void buildConfig(benchmark::State &state, bool selfAdjusting)
+{
+    const auto &data = fixture(state.range(0));
+    for (auto _ : state) {
+        // the builder moves its mounts into the config, it can't be reused
+        generator::ContainerCfgBuilder builder;
+        builder.setAppId("org.deepin.bench")
+          .setBasePath(data.basePath)
+          .setBundlePath(data.bundlePath)
+          .bindDefault()
+          .addExtraMounts(data.mounts)
+          .disablePatch();
+        if (selfAdjusting) {
+            builder.enableSelfAdjustingMount();
+        }
+
+        if (!builder.build()) {
+            state.SkipWithError(builder.getError().reason.c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(builder.getConfig());
+    }
+}
+
+void BM_ContainerCfgBuild(benchmark::State &state)
+{
+    buildConfig(state, false);
+}
+
+BENCHMARK(BM_ContainerCfgBuild)->Arg(2000);
+
+// builds the mount trie, then binds the ancestors of the missing mount points
+void BM_ContainerCfgBuildSelfAdjusting(benchmark::State &state)
+{
+    buildConfig(state, true);
+}
+
+BENCHMARK(BM_ContainerCfgBuildSelfAdjusting)->Arg(2000)->Unit(benchmark::kMillisecond);
+
+} // namespace
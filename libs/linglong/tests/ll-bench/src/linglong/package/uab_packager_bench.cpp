@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "linglong/bench/fixtures.h"
+#include "linglong/package/uab_packager.h"
+
+#include <QTemporaryDir>
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace linglong::package {
+
+class UABPackagerBenchmark
+{
+public:
+    // the blacklist in the source tree, which is installed to LINGLONG_DATA_DIR
+    static void loadBlackList(UABPackager &packager)
+    {
+        std::ifstream stream{ LINGLONG_BENCH_UAB_BLACKLIST };
+        std::string line;
+        while (std::getline(stream, line)) {
+            if (line.empty() || line.rfind('#', 0) == 0) {
+                continue;
+            }
+            packager.blackList.emplace(line);
+        }
+    }
+
+    static auto filteringFiles(const UABPackager &packager, const LayerDir &layer) noexcept
+    {
+        return packager.filteringFiles(layer);
+    }
+};
+
+} // namespace linglong::package
+
+using namespace linglong;
+using linglong::package::UABPackagerBenchmark;
+
+namespace {
+
+struct LayerFixture
+{
+    QTemporaryDir dir;
+    std::unique_ptr<package::LayerDir> layer;
+    std::unique_ptr<package::UABPackager> packager;
+};
+
+const LayerFixture &fixture(benchmark::State &state)
+{
+    static std::map<int64_t, std::unique_ptr<LayerFixture>> fixtures;
+    auto &ret = fixtures[state.range(0)];
+    if (ret) {
+        return *ret;
+    }
+
+    ret = std::make_unique<LayerFixture>();
+    ret->layer = std::make_unique<package::LayerDir>(ret->dir.filePath("layer"));
+    bench::makeFileTree(ret->layer->filesDirPath().toStdString(),
+                        static_cast<std::size_t>(state.range(0)));
+
+    ret->packager = std::make_unique<package::UABPackager>(QDir{ ret->dir.filePath("project") },
+                                                           QDir{ ret->dir.filePath("work") });
+    UABPackagerBenchmark::loadBlackList(*ret->packager);
+    // exclude a directory and some files, then include a file back from the directory
+    auto excluded = ret->packager->exclude({ "/000/01", "/000/02/file02", "/000/03/file03" });
+    auto included = ret->packager->include({ "/000/01/file04" });
+    if (!excluded || !included) {
+        state.SkipWithError("failed to set the filters");
+    }
+
+    return *ret;
+}
+
+void BM_UABFilteringFiles(benchmark::State &state)
+{
+    const auto &data = fixture(state);
+    for (auto _ : state) {
+        auto ret = UABPackagerBenchmark::filteringFiles(*data.packager, *data.layer);
+        if (!ret) {
+            state.SkipWithError(ret.error().message().toStdString().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(ret);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_UABFilteringFiles)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "linglong/bench/fixtures.h"
+#include "linglong/package/reference.h"
+#include "linglong/package/version.h"
+
+#include <QString>
+#include <QStringList>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace linglong;
+
+namespace {
+
+constexpr auto versionCount = 1000;
+
+QStringList toQStringList(const std::vector<std::string> &list)
+{
+    QStringList ret;
+    ret.reserve(static_cast<int>(list.size()));
+    for (const auto &str : list) {
+        ret.append(QString::fromStdString(str));
+    }
+    return ret;
+}
+
+void BM_VersionParse(benchmark::State &state)
+{
+    const auto versions = toQStringList(bench::makeVersions(versionCount));
+    for (auto _ : state) {
+        for (const auto &version : versions) {
+            auto ret = package::Version::parse(version);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(versions.size()));
+}
+
+BENCHMARK(BM_VersionParse);
+
+void BM_VersionTryParse(benchmark::State &state)
+{
+    const auto versions = bench::makeVersions(versionCount);
+    for (auto _ : state) {
+        for (const auto &version : versions) {
+            auto ret = package::Version::tryParse(version);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(versions.size()));
+}
+
+BENCHMARK(BM_VersionTryParse);
+
+// sorting is how the versions are compared in RepoCache::queryLayerItem
+void BM_VersionSort(benchmark::State &state)
+{
+    std::vector<package::Version> versions;
+    for (const auto &raw : bench::makeVersions(versionCount)) {
+        auto version = package::Version::tryParse(raw);
+        if (!version) {
+            state.SkipWithError(("failed to parse " + raw).c_str());
+            return;
+        }
+        versions.emplace_back(std::move(version).value());
+    }
+
+    for (auto _ : state) {
+        auto sorted = versions;
+        std::sort(sorted.begin(), sorted.end(), std::greater<>{});
+        benchmark::DoNotOptimize(sorted.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(versions.size()));
+}
+
+BENCHMARK(BM_VersionSort);
+
+void BM_ReferenceParse(benchmark::State &state)
+{
+    std::vector<std::string> references;
+    for (const auto &version : bench::makeVersions(versionCount)) {
+        references.emplace_back("main:org.deepin.bench.app/" + version + "/x86_64");
+    }
+
+    for (auto _ : state) {
+        for (const auto &reference : references) {
+            auto ret = package::Reference::parse(reference);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(references.size()));
+}
+
+BENCHMARK(BM_ReferenceParse);
+
+} // namespace
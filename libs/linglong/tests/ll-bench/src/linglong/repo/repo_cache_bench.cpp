@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "configure.h"
+#include "linglong/api/types/v1/Generators.hpp"
+#include "linglong/bench/fixtures.h"
+#include "linglong/repo/repo_cache.h"
+
+#include <nlohmann/json.hpp>
+#include <ostree.h>
+
+#include <QTemporaryDir>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+
+using namespace linglong;
+
+namespace {
+
+// the cache file is loaded as is if its version matches, the ostree repository is only used
+// for rebuilding the cache, so an empty one is enough
+struct RepoCacheFixture
+{
+    struct OstreeRepoDeleter
+    {
+        void operator()(OstreeRepo *repo) { g_clear_object(&repo); }
+    };
+
+    QTemporaryDir dir;
+    std::filesystem::path cacheFile;
+    api::types::v1::RepoConfigV2 config;
+    std::unique_ptr<OstreeRepo, OstreeRepoDeleter> ostreeRepo;
+    std::unique_ptr<repo::RepoCache> cache;
+};
+
+RepoCacheFixture *fixture(benchmark::State &state)
+{
+    static std::map<int64_t, std::unique_ptr<RepoCacheFixture>> fixtures;
+    auto layers = state.range(0);
+    auto &ret = fixtures[layers];
+    if (ret) {
+        return ret.get();
+    }
+
+    auto fixture = std::make_unique<RepoCacheFixture>();
+    auto repositoryCache = bench::makeRepositoryCache(static_cast<std::size_t>(layers));
+    repositoryCache.version = "2";
+    repositoryCache.llVersion = LINGLONG_VERSION;
+    fixture->config = repositoryCache.config;
+    fixture->cacheFile = std::filesystem::path{ fixture->dir.path().toStdString() } / "cache.json";
+    std::ofstream(fixture->cacheFile) << nlohmann::json(repositoryCache).dump();
+
+    auto repoDir = fixture->dir.filePath("repo").toStdString();
+    g_autoptr(GFile) repoPath = g_file_new_for_path(repoDir.c_str());
+    fixture->ostreeRepo.reset(ostree_repo_new(repoPath));
+
+    auto cache = repo::RepoCache::create(fixture->cacheFile, fixture->config, *fixture->ostreeRepo);
+    if (!cache) {
+        state.SkipWithError(cache.error().message().toStdString().c_str());
+        return nullptr;
+    }
+    fixture->cache = std::move(cache).value();
+
+    // the cache is rebuilt from the empty repository if the version of the file is outdated
+    if (fixture->cache->queryLayerItem({}).size() != static_cast<std::size_t>(layers)) {
+        state.SkipWithError("the synthetic cache file isn't loaded, is the cache version changed?");
+        return nullptr;
+    }
+
+    ret = std::move(fixture);
+    return ret.get();
+}
+
+void BM_RepoCacheLoad(benchmark::State &state)
+{
+    auto *data = fixture(state);
+    if (data == nullptr) {
+        return;
+    }
+
+    for (auto _ : state) {
+        auto cache = repo::RepoCache::create(data->cacheFile, data->config, *data->ostreeRepo);
+        benchmark::DoNotOptimize(cache);
+    }
+}
+
+BENCHMARK(BM_RepoCacheLoad)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+// all layers of an application, which are sorted by version
+void BM_RepoCacheQueryById(benchmark::State &state)
+{
+    auto *data = fixture(state);
+    if (data == nullptr) {
+        return;
+    }
+
+    repo::repoCacheQuery query{ .id = "org.deepin.bench.app0042" };
+    for (auto _ : state) {
+        auto layers = data->cache->queryLayerItem(query);
+        benchmark::DoNotOptimize(layers);
+    }
+}
+
+BENCHMARK(BM_RepoCacheQueryById)->Arg(5000);
+
+void BM_RepoCacheQueryByVersion(benchmark::State &state)
+{
+    auto *data = fixture(state);
+    if (data == nullptr) {
+        return;
+    }
+
+    repo::repoCacheQuery query{ .id = "org.deepin.bench.app0042",
+                                .channel = "main",
+                                .version = "0.0.1",
+                                .module = "binary" };
+    for (auto _ : state) {
+        auto layers = data->cache->queryLayerItem(query);
+        benchmark::DoNotOptimize(layers);
+    }
+}
+
+BENCHMARK(BM_RepoCacheQueryByVersion)->Arg(5000);
+
+// listing all layers, like `ll-cli list`
+void BM_RepoCacheQueryAll(benchmark::State &state)
+{
+    auto *data = fixture(state);
+    if (data == nullptr) {
+        return;
+    }
+
+    for (auto _ : state) {
+        auto layers = data->cache->queryLayerItem({});
+        benchmark::DoNotOptimize(layers);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_RepoCacheQueryAll)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "linglong/api/types/v1/Generators.hpp"
+#include "linglong/bench/fixtures.h"
+#include "linglong/oci-cfg-generators/container_cfg_builder.h"
+#include "linglong/utils/serialize/json.h"
+#include "ocppi/runtime/config/types/Generators.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <QTemporaryDir>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+using namespace linglong;
+
+namespace {
+
+std::optional<ocppi::runtime::config::types::Config> makeConfig(int64_t mounts)
+{
+    // the layers are only checked by the self adjusting mount, which isn't enabled here
+    QTemporaryDir bundle;
+    generator::ContainerCfgBuilder builder;
+    builder.setAppId("org.deepin.bench")
+      .setBasePath("/var/lib/linglong/layers/main/org.deepin.base/23.1.0.0/x86_64/binary/files")
+      .setBundlePath(bundle.path().toStdString())
+      .bindDefault()
+      .addExtraMounts(bench::makeMounts("/var/lib/linglong/extensions",
+                                        static_cast<std::size_t>(mounts)))
+      .disablePatch();
+    if (!builder.build()) {
+        return std::nullopt;
+    }
+
+    return builder.getConfig();
+}
+
+void BM_RepositoryCacheToJSON(benchmark::State &state)
+{
+    const auto cache = bench::makeRepositoryCache(static_cast<std::size_t>(state.range(0)));
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        auto data = nlohmann::json(cache).dump();
+        bytes = data.size();
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+
+BENCHMARK(BM_RepositoryCacheToJSON)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+void BM_RepositoryCacheFromJSON(benchmark::State &state)
+{
+    const auto data =
+      nlohmann::json(bench::makeRepositoryCache(static_cast<std::size_t>(state.range(0)))).dump();
+    for (auto _ : state) {
+        auto cache = utils::serialize::LoadJSON<api::types::v1::RepositoryCache>(data);
+        if (!cache) {
+            state.SkipWithError(cache.error().message().toStdString().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(cache);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+
+BENCHMARK(BM_RepositoryCacheFromJSON)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+void BM_OCIConfigToJSON(benchmark::State &state)
+{
+    const auto config = makeConfig(state.range(0));
+    if (!config) {
+        state.SkipWithError("failed to build the container config");
+        return;
+    }
+
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        auto data = nlohmann::json(*config).dump();
+        bytes = data.size();
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+
+BENCHMARK(BM_OCIConfigToJSON)->Arg(2000);
+
+void BM_OCIConfigFromJSON(benchmark::State &state)
+{
+    const auto config = makeConfig(state.range(0));
+    if (!config) {
+        state.SkipWithError("failed to build the container config");
+        return;
+    }
+
+    const auto data = nlohmann::json(*config).dump();
+    for (auto _ : state) {
+        auto ret = utils::serialize::LoadJSON<ocppi::runtime::config::types::Config>(data);
+        if (!ret) {
+            state.SkipWithError(ret.error().message().toStdString().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(ret);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+
+BENCHMARK(BM_OCIConfigFromJSON)->Arg(2000);
+
+} // namespace
@@ -0,0 +1,26 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "linglong/utils/global/initialize.h"
+
+#include <QByteArray>
+
+// Run with `--benchmark_out=<file> --benchmark_out_format=json` to save the results, see
+// tools/run-benchmark.sh for comparing the results of two commits.
+int main(int argc, char **argv)
+{
+    qputenv("QT_FORCE_STDERR_LOGGING", QByteArray("1"));
+    linglong::utils::global::installMessageHandler();
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
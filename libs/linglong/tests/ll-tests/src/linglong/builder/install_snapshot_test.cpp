@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <gtest/gtest.h>
+
+#include "linglong/builder/install_snapshot.h"
+
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+using linglong::builder::InstallSnapshot;
+
+namespace {
+
+void writeFile(const std::filesystem::path &path, const std::string &content)
+{
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream stream(path, std::ios::trunc);
+    stream << content;
+}
+
+bool contains(const std::vector<std::string> &paths, const std::string &path)
+{
+    return std::find(paths.begin(), paths.end(), path) != paths.end();
+}
+
+} // namespace
+
+TEST(InstallSnapshotTest, ChangedAndRemoved)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    std::filesystem::path root = dir.path().toStdString();
+
+    writeFile(root / "bin" / "demo", "demo");
+    writeFile(root / "lib" / "libdemo.so", "lib");
+    writeFile(root / "share" / "demo" / "data", "data");
+
+    auto previous = InstallSnapshot::scan(root);
+    ASSERT_TRUE(previous.has_value()) << previous.error().message().toStdString();
+    EXPECT_TRUE(contains(previous->entries(), "/bin/demo"));
+    EXPECT_TRUE(contains(previous->entries(), "/share/demo"));
+
+    auto unchanged = InstallSnapshot::scan(root);
+    ASSERT_TRUE(unchanged.has_value());
+    EXPECT_TRUE(unchanged->changedSince(*previous).empty());
+    EXPECT_TRUE(unchanged->removedSince(*previous).empty());
+
+    // replace the file, the inode changes even if mtime has a coarse granularity
+    std::filesystem::remove(root / "bin" / "demo");
+    writeFile(root / "bin" / "demo", "demo v2");
+    std::filesystem::remove_all(root / "share" / "demo");
+
+    auto current = InstallSnapshot::scan(root);
+    ASSERT_TRUE(current.has_value());
+    auto changed = current->changedSince(*previous);
+    EXPECT_TRUE(contains(changed, "/bin/demo"));
+    EXPECT_FALSE(contains(changed, "/lib/libdemo.so"));
+
+    auto removed = current->removedSince(*previous);
+    ASSERT_EQ(removed.size(), 2);
+    // children are removed before their parent
+    EXPECT_EQ(removed[0], "/share/demo/data");
+    EXPECT_EQ(removed[1], "/share/demo");
+}
+
+TEST(InstallSnapshotTest, SaveAndLoad)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    std::filesystem::path root = dir.path().toStdString();
+
+    writeFile(root / "output" / "bin" / "demo", "demo");
+    auto snapshot = InstallSnapshot::scan(root / "output");
+    ASSERT_TRUE(snapshot.has_value());
+    snapshot->rulesDigest = "digest";
+
+    auto ret = snapshot->save(root / "snapshot.json");
+    ASSERT_TRUE(ret.has_value()) << ret.error().message().toStdString();
+
+    auto loaded = InstallSnapshot::load(root / "snapshot.json");
+    ASSERT_TRUE(loaded.has_value()) << loaded.error().message().toStdString();
+    EXPECT_EQ(loaded->rulesDigest, "digest");
+    EXPECT_EQ(loaded->entries(), snapshot->entries());
+    EXPECT_TRUE(snapshot->changedSince(*loaded).empty());
+
+    writeFile(root / "broken.json", "{");
+    EXPECT_FALSE(InstallSnapshot::load(root / "broken.json").has_value());
+    EXPECT_FALSE(InstallSnapshot::load(root / "missing.json").has_value());
+}
@@ -0,0 +1,55 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <gtest/gtest.h>
+
+#include "linglong/builder/output_checker.h"
+
+#include <QTemporaryDir>
+
+#include <filesystem>
+#include <fstream>
+
+using linglong::builder::OutputChecker;
+
+namespace {
+
+void writeFile(const std::filesystem::path &path, const std::string &content)
+{
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream stream(path, std::ios::trunc);
+    stream << content;
+}
+
+} // namespace
+
+TEST(OutputCheckerTest, Check)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    std::filesystem::path root = dir.path().toStdString();
+    auto binary = root / "binary" / "files";
+    auto develop = root / "develop" / "files";
+
+    writeFile(binary / "share" / "applications" / "org.deepin.demo.desktop",
+              "[Desktop Entry]\nExec=demo\n");
+    writeFile(binary / "share" / "applications" / "demo.desktop", "Exec=demo\n");
+    writeFile(binary / "lib" / "systemd" / "user" / "demo.service", "[Unit]\n");
+    writeFile(binary / "share" / "doc" / "demo.service", "not a config file");
+    std::filesystem::create_directories(binary / "bin");
+    std::filesystem::copy_file("/bin/sh", binary / "bin" / "demo");
+    writeFile(develop / "include" / "demo.h", "");
+
+    auto report = OutputChecker("org.deepin.demo").check({ binary, develop, root / "missing" }, 2);
+    ASSERT_TRUE(report.has_value()) << report.error().message().toStdString();
+    EXPECT_EQ(report->scanned, 6);
+    EXPECT_EQ(report->invalidConfigs,
+              (std::vector<std::string>{ "/lib/systemd/user/demo.service",
+                                         "/share/applications/demo.desktop" }));
+    EXPECT_EQ(report->invalidEntries,
+              std::vector<std::string>{ "/share/applications/demo.desktop" });
+    EXPECT_EQ(report->executables, std::vector<std::string>{ "/bin/demo" });
+}
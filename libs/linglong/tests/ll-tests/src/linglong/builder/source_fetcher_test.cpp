@@ -126,6 +126,38 @@ TEST_F(SourceFetcherTest, gitSubmodules)
     }
 }
 
+// 测试git镜像目录
+// 场景：设置了git镜像目录
+// 预期：通过LINGLONG_GIT_MIRROR_DIR环境变量传递给脚本
+TEST_F(SourceFetcherTest, GitMirrorDir)
+{
+    api::types::v1::BuilderProjectSource source;
+    source.kind = "git";
+    source.url = "https://example.com/repo.git";
+    source.commit = "abcdef123456";
+    source.name = "repo";
+
+    QDir cacheDir("/tmp/cache");
+    QString mirrorDir;
+    auto mockCmd = std::make_shared<MockCommand>("mock");
+    mockCmd->wrapExecFunc = [&](const QStringList &args) {
+        return utils::error::Result<QString>("ok");
+    };
+    mockCmd->wrapSetEnvFunc = [&](const QString &name,
+                                  const QString &value) -> linglong::utils::command::Cmd & {
+        if (name == "LINGLONG_GIT_MIRROR_DIR") {
+            mirrorDir = value;
+        }
+        return *mockCmd;
+    };
+    SourceFetcher fetcher(source, cacheDir);
+    fetcher.setCommand(mockCmd);
+    fetcher.setGitMirrorDir(QDir("/tmp/mirrors"));
+    auto ret = fetcher.fetch(QDir("/tmp/dest"));
+    EXPECT_TRUE(ret.has_value()) << ret.error().message().toStdString();
+    EXPECT_EQ(mirrorDir.toStdString(), "/tmp/mirrors");
+}
+
 // 测试无效的source类型
 // 场景：提供无效的source.kind值
 // 预期：返回错误结果，错误码为-1
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linglong/api/types/v1/Generators.hpp"
+#include "linglong/cli/json_printer.h"
+
+namespace {
+
+linglong::api::types::v1::PackageInfoDisplay makeDisplay(int i)
+{
+    return linglong::api::types::v1::PackageInfoDisplay{
+        .arch = { "x86_64" },
+        .base = "main:org.deepin.base/23.1.0/x86_64",
+        .channel = "main",
+        .description = "description of package " + std::to_string(i),
+        .id = "org.deepin.demo" + std::to_string(i),
+        .kind = "app",
+        .packageInfoDisplayModule = "binary",
+        .name = "demo \"" + std::to_string(i) + "\"",
+        .schemaVersion = "1.0",
+        .size = i,
+        .version = "1.0.0." + std::to_string(i),
+    };
+}
+
+} // namespace
+
+using namespace linglong;
+
+TEST(JSONPrinter, StreamPackagesSameAsDump)
+{
+    linglong::cli::JSONPrinter printer;
+
+    std::vector<api::types::v1::PackageInfoDisplay> list;
+    for (int i = 0; i < 3; ++i) {
+        list.emplace_back(makeDisplay(i));
+    }
+
+    testing::internal::CaptureStdout();
+    printer.printPackages(list);
+    auto streamed = testing::internal::GetCapturedStdout();
+    EXPECT_EQ(streamed, nlohmann::json(list).dump() + "\n");
+
+    testing::internal::CaptureStdout();
+    printer.printPackages({});
+    streamed = testing::internal::GetCapturedStdout();
+    EXPECT_EQ(streamed, "[]\n");
+}
+
+TEST(JSONPrinter, StreamSearchResultSameAsDump)
+{
+    linglong::cli::JSONPrinter printer;
+
+    std::map<std::string, std::vector<api::types::v1::PackageInfoV2>> result;
+    for (const auto *repo : { "stable", "testing" }) {
+        for (int i = 0; i < 3; ++i) {
+            nlohmann::json pkg = makeDisplay(i);
+            result[repo].emplace_back(pkg.get<api::types::v1::PackageInfoV2>());
+        }
+    }
+
+    testing::internal::CaptureStdout();
+    printer.printSearchResult(result);
+    auto streamed = testing::internal::GetCapturedStdout();
+    EXPECT_EQ(streamed, nlohmann::json(result).dump() + "\n");
+}
@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linglong/package/erofs_profile.h"
+
+#include <algorithm>
+
+using namespace linglong;
+
+TEST(ErofsProfileTest, Profiles)
+{
+    auto names = package::erofsProfileNames();
+    ASSERT_FALSE(names.empty());
+    EXPECT_EQ(names.front(), package::defaultErofsProfile().name);
+    for (const auto &name : names) {
+        auto profile = package::erofsProfile(name);
+        ASSERT_TRUE(profile.has_value()) << name;
+        EXPECT_EQ(profile->name, name);
+        // every profile must use the same block size
+        auto args = profile->args();
+        EXPECT_NE(std::find(args.begin(), args.end(), "-b4096"), args.end()) << name;
+    }
+
+    EXPECT_FALSE(package::erofsProfile("unknown").has_value());
+}
+
+TEST(ErofsProfileTest, Args)
+{
+    // the default profile keeps the parameters used before profiles were introduced
+    const auto &profile = package::defaultErofsProfile();
+    EXPECT_EQ(profile.args(),
+              (std::vector<std::string>{ "-zlz4",
+                                         "-Efragments,dedupe,ztailpacking",
+                                         "-C1048576",
+                                         "-b4096" }));
+    EXPECT_EQ(profile.args("lzma").front(), "-zlzma");
+}
@@ -172,6 +172,74 @@ TEST_F(LayerPackagerTest, LayerPackagerUnpackFsck)
       << "'hello' not found in unpack dir" << filesDir;
 }
 
+TEST_F(LayerPackagerTest, Digest)
+{
+    char tempPath[] = "/var/tmp/linglong-layer-digest-XXXXXX";
+    std::filesystem::path dirPath = mkdtemp(tempPath);
+    std::filesystem::create_directories(dirPath / "files" / "bin");
+    std::ofstream(dirPath / "files" / "bin" / "hello") << "hello";
+    std::filesystem::create_symlink("bin/hello", dirPath / "files" / "hello");
+    auto layerDir = package::LayerDir(dirPath.string().c_str());
+
+    auto digest = LayerPackager::digestOf(layerDir);
+    ASSERT_TRUE(digest.has_value()) << digest.error().message().toStdString();
+    auto same = LayerPackager::digestOf(layerDir);
+    ASSERT_TRUE(same.has_value());
+    EXPECT_EQ(*digest, *same);
+
+    // 修改权限
+    std::filesystem::permissions(dirPath / "files" / "bin" / "hello",
+                                 std::filesystem::perms::owner_exec,
+                                 std::filesystem::perm_options::add);
+    auto modeChanged = LayerPackager::digestOf(layerDir);
+    ASSERT_TRUE(modeChanged.has_value());
+    EXPECT_NE(*digest, *modeChanged);
+
+    // 修改文件内容
+    std::ofstream(dirPath / "files" / "bin" / "hello", std::ios::trunc) << "world";
+    auto contentChanged = LayerPackager::digestOf(layerDir);
+    ASSERT_TRUE(contentChanged.has_value());
+    EXPECT_NE(*modeChanged, *contentChanged);
+
+    std::error_code ec;
+    std::filesystem::remove_all(dirPath, ec);
+}
+
+TEST_F(LayerPackagerTest, PackWithImageCache)
+{
+    char tempPath[] = "/var/tmp/linglong-layer-cache-XXXXXX";
+    std::filesystem::path tmpPath = mkdtemp(tempPath);
+    auto layerFile = package::LayerFile::New(layerFilePath.string().c_str());
+    ASSERT_TRUE(layerFile.has_value()) << layerFile.error().message().toStdString();
+    package::LayerPackager unpacker;
+    auto layerDir = unpacker.unpack(**layerFile);
+    ASSERT_TRUE(layerDir.has_value()) << layerDir.error().message().toStdString();
+
+    package::LayerPackager packager;
+    packager.setCompressor("lz4");
+    packager.setImageCacheDir(tmpPath / "cache");
+    auto first = packager.pack(*layerDir, (tmpPath / "first.layer").string().c_str(), "digest");
+    ASSERT_TRUE(first.has_value()) << first.error().message().toStdString();
+    auto second = packager.pack(*layerDir, (tmpPath / "second.layer").string().c_str(), "digest");
+    ASSERT_TRUE(second.has_value()) << second.error().message().toStdString();
+
+    // 内容摘要相同时只生成一个镜像
+    auto cached = std::distance(std::filesystem::directory_iterator(tmpPath / "cache"),
+                                std::filesystem::directory_iterator());
+    EXPECT_EQ(cached, 1);
+
+    std::ifstream firstFile(tmpPath / "first.layer", std::ios::binary);
+    std::ifstream secondFile(tmpPath / "second.layer", std::ios::binary);
+    std::stringstream firstContent;
+    std::stringstream secondContent;
+    firstContent << firstFile.rdbuf();
+    secondContent << secondFile.rdbuf();
+    EXPECT_EQ(firstContent.str(), secondContent.str());
+
+    std::error_code ec;
+    std::filesystem::remove_all(tmpPath, ec);
+}
+
 TEST_F(LayerPackagerTest, InitWorkDir)
 {
     char tempPath[] = "/var/tmp/linglong-layer-XXXXXX";
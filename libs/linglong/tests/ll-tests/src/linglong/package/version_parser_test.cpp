@@ -0,0 +1,196 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <gtest/gtest.h>
+
+#include "linglong/package/semver.hpp"
+#include "linglong/package/version_parser.h"
+
+#include <QRegularExpression>
+
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace linglong::package;
+
+namespace {
+
+// The parsers are compared with the regular expressions they replaced, semver::version::parse
+// is still used by the semver tests, the others are copied here.
+
+std::optional<VersionV1Parts> parseVersionV1ByRegex(const std::string &raw)
+{
+    static QRegularExpression regexExp(
+      R"(^(0|[1-9]\d*)\.(0|[1-9]\d*)\.(0|[1-9]\d*)(?:\.(0|[1-9]\d*))?$)");
+    auto matched = regexExp.match(QString::fromStdString(raw));
+    if (!matched.hasMatch()) {
+        return std::nullopt;
+    }
+
+    VersionV1Parts parts;
+    bool ok = false;
+    parts.major = matched.captured(1).toLongLong(&ok);
+    if (!ok) {
+        return std::nullopt;
+    }
+    parts.minor = matched.captured(2).toLongLong(&ok);
+    if (!ok) {
+        return std::nullopt;
+    }
+    parts.patch = matched.captured(3).toLongLong(&ok);
+    if (!ok) {
+        return std::nullopt;
+    }
+    if (!matched.captured(4).isNull()) {
+        parts.tweak = matched.captured(4).toLongLong(&ok);
+        if (!ok) {
+            return std::nullopt;
+        }
+    }
+
+    return parts;
+}
+
+std::optional<std::vector<std::string>> splitReferenceByRegex(const std::string &raw)
+{
+    static QRegularExpression referenceRegExp(
+      R"((?<channel>[^:]+):(?<id>[^\/]+)\/(?<version>[^\/]+)\/(?<architecture>[^\/]+))");
+    auto matches = referenceRegExp.match(QString::fromStdString(raw));
+    if (!matches.hasMatch()) {
+        return std::nullopt;
+    }
+
+    return std::vector<std::string>{ matches.captured("channel").toStdString(),
+                                     matches.captured("id").toStdString(),
+                                     matches.captured("version").toStdString(),
+                                     matches.captured("architecture").toStdString() };
+}
+
+void compare(const std::string &raw)
+{
+    for (auto strict : { true, false }) {
+        std::optional<semver::version> expected;
+        try {
+            expected = semver::version::parse(raw, strict);
+        } catch (const semver::semver_exception &) {
+        }
+
+        auto parts = parseSemver(raw, strict);
+        ASSERT_EQ(parts.has_value(), expected.has_value()) << raw << " strict: " << strict;
+        if (expected) {
+            EXPECT_EQ(parts->major, expected->major()) << raw;
+            EXPECT_EQ(parts->minor, expected->minor()) << raw;
+            EXPECT_EQ(parts->patch, expected->patch()) << raw;
+            EXPECT_EQ(parts->prerelease, expected->prerelease()) << raw;
+            EXPECT_EQ(parts->buildMeta, expected->build_meta()) << raw;
+            EXPECT_EQ(parts->security, expected->security()) << raw;
+            EXPECT_EQ(parts->hasPatch, expected->has_patch()) << raw;
+        }
+    }
+
+    auto expectedV1 = parseVersionV1ByRegex(raw);
+    auto partsV1 = parseVersionV1(raw);
+    ASSERT_EQ(partsV1.has_value(), expectedV1.has_value()) << raw;
+    if (expectedV1) {
+        EXPECT_EQ(partsV1->major, expectedV1->major) << raw;
+        EXPECT_EQ(partsV1->minor, expectedV1->minor) << raw;
+        EXPECT_EQ(partsV1->patch, expectedV1->patch) << raw;
+        EXPECT_EQ(partsV1->tweak, expectedV1->tweak) << raw;
+    }
+
+    auto expectedReference = splitReferenceByRegex(raw);
+    auto reference = splitReference(raw);
+    ASSERT_EQ(reference.has_value(), expectedReference.has_value()) << raw;
+    if (expectedReference) {
+        EXPECT_EQ(reference->channel, expectedReference->at(0)) << raw;
+        EXPECT_EQ(reference->id, expectedReference->at(1)) << raw;
+        EXPECT_EQ(reference->version, expectedReference->at(2)) << raw;
+        EXPECT_EQ(reference->architecture, expectedReference->at(3)) << raw;
+    }
+}
+
+const std::vector<std::string> seeds = {
+    "1.2.3",
+    "v1.2",
+    "1.2.3-alpha.1+security.5",
+    "1.0.0-rc.1+build.2",
+    "1.0.0.0",
+    "0.0.0.1",
+    "main:org.deepin.demo/1.0.0.1/x86_64",
+    "stable:org.deepin.demo/1.2.3-beta+security.1/arm64",
+    "18446744073709551615.0.0",
+    "18446744073709551616.0.0",
+    "9223372036854775807.0.0.0",
+    "9223372036854775808.0.0",
+    "1.0.0-01",
+    "1.0.0-0a",
+    "1.0.0-99999999999999999999",
+    "1.0.0+security.0",
+    "1.0.0+security.01",
+    "1.0.0+xsecurity.12.3",
+    "1.0.0\n",
+    "::a/b/c",
+    "a::b/c/d/e",
+    "a:b//c/d",
+};
+
+} // namespace
+
+TEST(VersionParser, Seeds)
+{
+    for (const auto &seed : seeds) {
+        compare(seed);
+    }
+}
+
+TEST(VersionParser, Differential)
+{
+    constexpr std::string_view alphabet = "0123456789..--++v::://aZs\n x";
+    std::mt19937 rng(20250101); // NOLINT
+    auto pick = [&rng](std::size_t size) {
+        return static_cast<std::size_t>(rng() % size);
+    };
+
+    for (int i = 0; i < 20000; ++i) {
+        std::string raw;
+        if (rng() % 2 == 0) {
+            // mutate a seed, most of the random strings are rejected at the beginning
+            raw = seeds[pick(seeds.size())];
+            for (auto edits = pick(4) + 1; edits > 0; --edits) {
+                auto pos = pick(raw.size() + 1);
+                auto c = alphabet[pick(alphabet.size())];
+                switch (pick(3)) {
+                case 0:
+                    raw.insert(raw.begin() + static_cast<std::ptrdiff_t>(pos), c);
+                    break;
+                case 1:
+                    if (pos < raw.size()) {
+                        raw.erase(pos, 1);
+                    }
+                    break;
+                default:
+                    if (pos < raw.size()) {
+                        raw[pos] = c;
+                    }
+                    break;
+                }
+            }
+        } else {
+            for (auto length = pick(14); length > 0; --length) {
+                raw.push_back(alphabet[pick(alphabet.size())]);
+            }
+        }
+
+        compare(raw);
+        if (HasFatalFailure()) {
+            return;
+        }
+    }
+}
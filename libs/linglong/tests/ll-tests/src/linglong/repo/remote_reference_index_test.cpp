@@ -0,0 +1,130 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <gtest/gtest.h>
+
+#include "linglong/repo/remote_reference_index.h"
+
+using namespace linglong;
+
+namespace {
+
+api::types::v1::PackageInfoV2 makeRecord(const std::string &id,
+                                         const std::string &version,
+                                         const std::string &module = "binary",
+                                         const std::string &channel = "main")
+{
+    return api::types::v1::PackageInfoV2{
+        .arch = { "x86_64" },
+        .channel = channel,
+        .id = id,
+        .kind = "app",
+        .packageInfoV2Module = module,
+        .name = id,
+        .version = version,
+    };
+}
+
+package::FuzzyReference makeFuzzy(const QString &id,
+                                  const std::optional<QString> &version = std::nullopt,
+                                  const std::optional<QString> &channel = std::nullopt)
+{
+    auto fuzzy = package::FuzzyReference::create(channel, id, version, std::nullopt);
+    EXPECT_TRUE(fuzzy.has_value());
+    return *fuzzy;
+}
+
+std::optional<package::Version> parseVersion(const QString &raw)
+{
+    auto version = package::Version::parse(raw);
+    EXPECT_TRUE(version.has_value());
+    return *version;
+}
+
+const std::vector<api::types::v1::PackageInfoV2> records{
+    makeRecord("org.deepin.demo", "1.0.0.1"),
+    makeRecord("org.deepin.demo", "1.1.0.0"),
+    makeRecord("org.deepin.demo", "1.0.0.2"),
+    makeRecord("org.deepin.demo", "1.2.0.0", "develop"),
+    makeRecord("org.deepin.demo", "2.0.0.0", "binary", "beta"),
+    makeRecord("org.deepin.demo.other", "3.0.0.0"),
+    makeRecord("org.deepin.demo", ""),
+};
+
+} // namespace
+
+TEST(RemoteReferenceIndexTest, SkipInvalidRecords)
+{
+    repo::RemoteReferenceIndex index(records);
+    EXPECT_EQ(index.size(), records.size() - 1);
+}
+
+TEST(RemoteReferenceIndexTest, Latest)
+{
+    repo::RemoteReferenceIndex index(records);
+
+    auto ref = index.find(makeFuzzy("org.deepin.demo"), "binary", std::nullopt, false);
+    ASSERT_TRUE(ref.has_value());
+    EXPECT_EQ(ref->version.toString().toStdString(), "2.0.0.0");
+    EXPECT_EQ(ref->channel.toStdString(), "beta");
+
+    ref = index.find(makeFuzzy("org.deepin.demo", std::nullopt, "main"),
+                     "binary",
+                     std::nullopt,
+                     false);
+    ASSERT_TRUE(ref.has_value());
+    EXPECT_EQ(ref->version.toString().toStdString(), "1.1.0.0");
+
+    ref = index.find(makeFuzzy("org.deepin.demo"), "develop", std::nullopt, false);
+    ASSERT_TRUE(ref.has_value());
+    EXPECT_EQ(ref->version.toString().toStdString(), "1.2.0.0");
+
+    EXPECT_FALSE(
+      index.find(makeFuzzy("org.deepin.missing"), "binary", std::nullopt, false).has_value());
+}
+
+TEST(RemoteReferenceIndexTest, ExactVersion)
+{
+    repo::RemoteReferenceIndex index(records);
+
+    auto ref = index.find(makeFuzzy("org.deepin.demo", "1.0.0.1"),
+                          "binary",
+                          parseVersion("1.0.0.1"),
+                          false);
+    ASSERT_TRUE(ref.has_value());
+    EXPECT_EQ(ref->version.toString().toStdString(), "1.0.0.1");
+
+    EXPECT_FALSE(index
+                   .find(makeFuzzy("org.deepin.demo", "1.0.0.3"),
+                         "binary",
+                         parseVersion("1.0.0.3"),
+                         false)
+                   .has_value());
+}
+
+TEST(RemoteReferenceIndexTest, SemanticVersion)
+{
+    repo::RemoteReferenceIndex index(records);
+
+    auto ref = index.find(makeFuzzy("org.deepin.demo", "1.0.0"),
+                          "binary",
+                          parseVersion("1.0.0"),
+                          true);
+    ASSERT_TRUE(ref.has_value());
+    EXPECT_EQ(ref->version.toString().toStdString(), "1.0.0.2");
+}
+
+TEST(RemoteReferenceIndexTest, SameVersionKeepsResponseOrder)
+{
+    repo::RemoteReferenceIndex index({
+      makeRecord("org.deepin.demo", "1.0.0.0", "runtime", "main"),
+      makeRecord("org.deepin.demo", "1.0.0.0", "binary", "beta"),
+    });
+
+    auto ref = index.find(makeFuzzy("org.deepin.demo"), "binary", std::nullopt, false);
+    ASSERT_TRUE(ref.has_value());
+    EXPECT_EQ(ref->channel.toStdString(), "main");
+}
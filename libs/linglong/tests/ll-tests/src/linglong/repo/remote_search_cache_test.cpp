@@ -0,0 +1,130 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <gtest/gtest.h>
+
+#include "linglong/repo/remote_search_cache.h"
+
+#include <cstdlib>
+
+using namespace linglong::repo;
+using namespace std::chrono_literals;
+
+namespace {
+
+RemoteSearchKey makeKey(const std::string &id, const std::string &repo = "stable")
+{
+    return RemoteSearchKey{
+        .repo = repo,
+        .url = "https://mirror-repo-linglong.deepin.com",
+        .id = id,
+        .channel = "",
+        .version = "",
+        .arch = "x86_64",
+    };
+}
+
+std::vector<linglong::api::types::v1::PackageInfoV2> makeResult(const std::string &id)
+{
+    return { linglong::api::types::v1::PackageInfoV2{
+      .arch = { "x86_64" },
+      .channel = "main",
+      .id = id,
+      .kind = "app",
+      .packageInfoV2Module = "binary",
+      .name = id,
+      .version = "1.0.0.0",
+    } };
+}
+
+} // namespace
+
+TEST(RemoteSearchCacheTest, HitWithinTTL)
+{
+    RemoteSearchCache cache(60s);
+    auto now = RemoteSearchCache::Clock::now();
+
+    cache.insert(makeKey("org.deepin.demo"), makeResult("org.deepin.demo"), now);
+
+    auto cached = cache.find(makeKey("org.deepin.demo"), now + 59s);
+    ASSERT_TRUE(cached.has_value());
+    ASSERT_EQ(cached->size(), 1);
+    EXPECT_EQ(cached->front().id, "org.deepin.demo");
+}
+
+TEST(RemoteSearchCacheTest, MissOnDifferentKey)
+{
+    RemoteSearchCache cache(60s);
+    auto now = RemoteSearchCache::Clock::now();
+
+    cache.insert(makeKey("org.deepin.demo"), makeResult("org.deepin.demo"), now);
+
+    EXPECT_FALSE(cache.find(makeKey("org.deepin.other"), now).has_value());
+    EXPECT_FALSE(cache.find(makeKey("org.deepin.demo", "testing"), now).has_value());
+
+    auto key = makeKey("org.deepin.demo");
+    key.arch = "arm64";
+    EXPECT_FALSE(cache.find(key, now).has_value());
+}
+
+TEST(RemoteSearchCacheTest, ExpireAfterTTL)
+{
+    RemoteSearchCache cache(60s);
+    auto now = RemoteSearchCache::Clock::now();
+
+    cache.insert(makeKey("org.deepin.demo"), makeResult("org.deepin.demo"), now);
+
+    EXPECT_FALSE(cache.find(makeKey("org.deepin.demo"), now + 60s).has_value());
+}
+
+TEST(RemoteSearchCacheTest, Disabled)
+{
+    RemoteSearchCache cache(0s);
+
+    cache.insert(makeKey("org.deepin.demo"), makeResult("org.deepin.demo"));
+
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.find(makeKey("org.deepin.demo")).has_value());
+}
+
+TEST(RemoteSearchCacheTest, Clear)
+{
+    RemoteSearchCache cache(60s);
+
+    cache.insert(makeKey("org.deepin.demo"), makeResult("org.deepin.demo"));
+    ASSERT_EQ(cache.size(), 1);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.find(makeKey("org.deepin.demo")).has_value());
+}
+
+TEST(RemoteSearchCacheTest, EvictOldest)
+{
+    RemoteSearchCache cache(60s, 2);
+    auto now = RemoteSearchCache::Clock::now();
+
+    cache.insert(makeKey("a"), makeResult("a"), now);
+    cache.insert(makeKey("b"), makeResult("b"), now + 1s);
+    cache.insert(makeKey("c"), makeResult("c"), now + 2s);
+
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_FALSE(cache.find(makeKey("a"), now + 2s).has_value());
+    EXPECT_TRUE(cache.find(makeKey("b"), now + 2s).has_value());
+    EXPECT_TRUE(cache.find(makeKey("c"), now + 2s).has_value());
+}
+
+TEST(RemoteSearchCacheTest, TTLFromEnv)
+{
+    ::setenv("LINGLONG_SEARCH_CACHE_TTL", "0", 1);
+    EXPECT_EQ(RemoteSearchCache::ttlFromEnv(), 0s);
+
+    ::setenv("LINGLONG_SEARCH_CACHE_TTL", "invalid", 1);
+    EXPECT_EQ(RemoteSearchCache::ttlFromEnv(), RemoteSearchCache::DefaultTTL);
+
+    ::unsetenv("LINGLONG_SEARCH_CACHE_TTL");
+    EXPECT_EQ(RemoteSearchCache::ttlFromEnv(), RemoteSearchCache::DefaultTTL);
+}
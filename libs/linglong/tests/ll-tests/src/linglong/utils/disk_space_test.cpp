@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linglong/utils/disk_space.h"
+
+#include <QTemporaryDir>
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+using namespace linglong::utils;
+
+TEST(DiskSpace, FormatSize)
+{
+    EXPECT_EQ(formatSize(0), "0 B");
+    EXPECT_EQ(formatSize(1023), "1023 B");
+    EXPECT_EQ(formatSize(1536), "1.5 KiB");
+    EXPECT_EQ(formatSize(uintmax_t{ 3 } << 30), "3.0 GiB");
+}
+
+TEST(DiskSpace, Check)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    std::filesystem::path root = dir.path().toStdString();
+
+    // the target doesn't need to exist
+    auto ret = checkDiskSpace({ { root / "not" / "exists", 1, 1 } });
+    EXPECT_TRUE(ret.has_value()) << ret.error().message().toStdString();
+
+    ret = checkDiskSpace({ { root, std::numeric_limits<uintmax_t>::max() / 2, 0 } });
+    ASSERT_FALSE(ret.has_value());
+    EXPECT_TRUE(ret.error().message().contains("not enough space"))
+      << ret.error().message().toStdString();
+
+    // requirements on the same filesystem are added up
+    ret = checkDiskSpace({ { root, std::numeric_limits<uintmax_t>::max() / 4, 0 },
+                           { root / "sub", std::numeric_limits<uintmax_t>::max() / 4, 0 } });
+    EXPECT_FALSE(ret.has_value());
+}
+
+TEST(DiskSpace, DirectoryUsage)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    std::filesystem::path root = dir.path().toStdString();
+
+    std::filesystem::create_directories(root / "a" / "b");
+    std::ofstream(root / "a" / "file") << "0123456789";
+    std::filesystem::create_symlink("file", root / "a" / "link");
+
+    auto usage = directoryUsage(root);
+    ASSERT_TRUE(usage.has_value()) << usage.error().message().toStdString();
+    EXPECT_EQ(usage->inodes, 4);
+    EXPECT_GE(usage->bytes, 10);
+
+    EXPECT_FALSE(directoryUsage(root / "missing").has_value());
+}
+
+TEST(DiskSpace, SameFilesystem)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    std::filesystem::path root = dir.path().toStdString();
+
+    auto ret = isSameFilesystem(root, root / "not" / "exists");
+    ASSERT_TRUE(ret.has_value()) << ret.error().message().toStdString();
+    EXPECT_TRUE(*ret);
+}
@@ -0,0 +1,66 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <gtest/gtest.h>
+
+#include "linglong/utils/lru_cache.h"
+
+#include <string>
+
+using linglong::utils::LRUCache;
+
+TEST(LRUCacheTest, GetAndPut)
+{
+    LRUCache<std::string, int> cache(2);
+
+    EXPECT_FALSE(cache.get("a").has_value());
+
+    cache.put("a", 1);
+    auto value = cache.get("a");
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(*value, 1);
+
+    cache.put("a", 2);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.get("a").value_or(0), 2);
+}
+
+TEST(LRUCacheTest, EvictLeastRecentlyUsed)
+{
+    LRUCache<std::string, int> cache(2);
+
+    cache.put("a", 1);
+    cache.put("b", 2);
+    // "a" is used after "b", so "b" should be evicted
+    EXPECT_TRUE(cache.get("a").has_value());
+    cache.put("c", 3);
+
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_TRUE(cache.get("a").has_value());
+    EXPECT_FALSE(cache.get("b").has_value());
+    EXPECT_TRUE(cache.get("c").has_value());
+}
+
+TEST(LRUCacheTest, ZeroCapacity)
+{
+    LRUCache<std::string, int> cache(0);
+
+    cache.put("a", 1);
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.get("a").has_value());
+}
+
+TEST(LRUCacheTest, Clear)
+{
+    LRUCache<std::string, int> cache(2);
+
+    cache.put("a", 1);
+    cache.put("b", 2);
+    cache.clear();
+
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.get("a").has_value());
+}
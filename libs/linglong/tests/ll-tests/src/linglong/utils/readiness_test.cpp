@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linglong/utils/readiness.h"
+
+#include <cstdlib>
+
+using namespace std::chrono_literals;
+
+TEST(Readiness, NotifyReady)
+{
+    auto listener = linglong::utils::ReadinessListener::create();
+    ASSERT_TRUE(listener.has_value());
+    ASSERT_EQ(listener->address().front(), '@');
+
+    ::setenv("NOTIFY_SOCKET", listener->address().c_str(), 1);
+    auto ret = linglong::utils::notifyReady();
+    ::unsetenv("NOTIFY_SOCKET");
+    ASSERT_TRUE(ret.has_value());
+
+    EXPECT_TRUE(listener->wait(1s).has_value());
+}
+
+TEST(Readiness, Timeout)
+{
+    auto listener = linglong::utils::ReadinessListener::create();
+    ASSERT_TRUE(listener.has_value());
+
+    EXPECT_FALSE(listener->wait(10ms).has_value());
+}
+
+TEST(Readiness, NoNotifySocket)
+{
+    ::unsetenv("NOTIFY_SOCKET");
+    EXPECT_TRUE(linglong::utils::notifyReady().has_value());
+}
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "disk_space.h"
+
+#include "linglong/utils/log/log.h"
+
+#include <array>
+#include <cerrno>
+#include <map>
+#include <system_error>
+
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+
+namespace linglong::utils {
+
+namespace {
+
+// the nearest existing path, the target of an operation is usually created by the operation
+std::filesystem::path existingPath(const std::filesystem::path &path) noexcept
+{
+    auto current = path.lexically_normal();
+    std::error_code ec;
+    while (!current.empty() && current != current.root_path()
+           && !std::filesystem::exists(current, ec)) {
+        current = current.parent_path();
+    }
+
+    return current.empty() ? "." : current;
+}
+
+struct Filesystem
+{
+    std::filesystem::path path;
+    uintmax_t bytes{ 0 };
+    uintmax_t inodes{ 0 };
+};
+
+} // namespace
+
+std::string formatSize(uintmax_t bytes) noexcept
+{
+    constexpr std::array units{ "B", "KiB", "MiB", "GiB", "TiB" };
+    auto size = static_cast<double>(bytes);
+    std::size_t unit = 0;
+    while (size >= 1024 && unit + 1 < units.size()) {
+        size /= 1024;
+        ++unit;
+    }
+
+    if (unit == 0) {
+        return fmt::format("{} B", bytes);
+    }
+    return fmt::format("{:.1f} {}", size, units[unit]);
+}
+
+error::Result<bool> isSameFilesystem(const std::filesystem::path &lhs,
+                                     const std::filesystem::path &rhs) noexcept
+{
+    LINGLONG_TRACE(fmt::format("check filesystem of {} and {}", lhs, rhs).c_str());
+
+    struct stat lst{};
+    struct stat rst{};
+    if (::stat(existingPath(lhs).c_str(), &lst) == -1
+        || ::stat(existingPath(rhs).c_str(), &rst) == -1) {
+        return LINGLONG_ERR("stat", errno);
+    }
+
+    return lst.st_dev == rst.st_dev;
+}
+
+error::Result<void> checkDiskSpace(const std::vector<SpaceRequirement> &requirements) noexcept
+{
+    LINGLONG_TRACE("check disk space");
+
+    std::map<dev_t, Filesystem> filesystems;
+    for (const auto &requirement : requirements) {
+        auto path = existingPath(requirement.path);
+        struct stat st{};
+        if (::stat(path.c_str(), &st) == -1) {
+            return LINGLONG_ERR(fmt::format("failed to stat {}", path).c_str(), errno);
+        }
+
+        auto &fs = filesystems[st.st_dev];
+        if (fs.path.empty()) {
+            fs.path = path;
+        }
+        fs.bytes += requirement.bytes;
+        fs.inodes += requirement.inodes;
+    }
+
+    for (const auto &[dev, fs] : filesystems) {
+        struct statvfs vfs{};
+        if (::statvfs(fs.path.c_str(), &vfs) == -1) {
+            return LINGLONG_ERR(fmt::format("failed to statvfs {}", fs.path).c_str(), errno);
+        }
+
+        // f_bavail and f_favail are the amounts available to unprivileged users
+        auto availableBytes = static_cast<uintmax_t>(vfs.f_bavail) * vfs.f_frsize;
+        if (fs.bytes > availableBytes) {
+            return LINGLONG_ERR(
+              fmt::format("not enough space on the filesystem of {}: {} is required, {} is "
+                          "available, please free at least {}",
+                          fs.path,
+                          formatSize(fs.bytes),
+                          formatSize(availableBytes),
+                          formatSize(fs.bytes - availableBytes))
+                .c_str());
+        }
+
+        auto availableInodes = static_cast<uintmax_t>(vfs.f_favail);
+        if (vfs.f_files != 0 && fs.inodes > availableInodes) {
+            return LINGLONG_ERR(
+              fmt::format("not enough inodes on the filesystem of {}: {} are required, {} are "
+                          "available, please remove at least {} files",
+                          fs.path,
+                          fs.inodes,
+                          availableInodes,
+                          fs.inodes - availableInodes)
+                .c_str());
+        }
+
+        LogD("{} requires {} and {} inodes, {} and {} inodes are available",
+             fs.path,
+             formatSize(fs.bytes),
+             fs.inodes,
+             formatSize(availableBytes),
+             availableInodes);
+    }
+
+    return LINGLONG_OK;
+}
+
+error::Result<DirectoryUsage> directoryUsage(const std::filesystem::path &dir) noexcept
+{
+    LINGLONG_TRACE(fmt::format("calculate usage of {}", dir).c_str());
+
+    DirectoryUsage usage;
+    std::error_code ec;
+    for (auto iter = std::filesystem::recursive_directory_iterator(dir, ec);
+         iter != std::filesystem::recursive_directory_iterator();
+         iter.increment(ec)) {
+        if (ec) {
+            break;
+        }
+
+        struct stat st{};
+        if (::lstat(iter->path().c_str(), &st) == -1) {
+            return LINGLONG_ERR(fmt::format("failed to stat {}", iter->path()).c_str(), errno);
+        }
+        usage.bytes += static_cast<uintmax_t>(st.st_size);
+        ++usage.inodes;
+    }
+    if (ec) {
+        return LINGLONG_ERR(fmt::format("failed to iterate {}: {}", dir, ec.message()).c_str());
+    }
+
+    return usage;
+}
+
+} // namespace linglong::utils
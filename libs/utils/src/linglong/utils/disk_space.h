@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linglong/utils/error/error.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace linglong::utils {
+
+// SpaceRequirement is the estimated space an operation writes to the filesystem of path,
+// path doesn't need to exist, its nearest existing parent is used.
+struct SpaceRequirement
+{
+    std::filesystem::path path;
+    uintmax_t bytes{ 0 };
+    uintmax_t inodes{ 0 };
+};
+
+struct DirectoryUsage
+{
+    uintmax_t bytes{ 0 };
+    uintmax_t inodes{ 0 };
+};
+
+// Check the free space and inodes of the filesystems before writing to them, requirements on
+// the same filesystem are added up. The error tells how much space is missing on which
+// filesystem. Filesystems without an inode limit (e.g. btrfs) only have their space checked.
+error::Result<void> checkDiskSpace(const std::vector<SpaceRequirement> &requirements) noexcept;
+
+// apparent size and number of entries of dir, symlinks are not followed
+error::Result<DirectoryUsage> directoryUsage(const std::filesystem::path &dir) noexcept;
+
+error::Result<bool> isSameFilesystem(const std::filesystem::path &lhs,
+                                     const std::filesystem::path &rhs) noexcept;
+
+// e.g. "1.5 GiB"
+std::string formatSize(uintmax_t bytes) noexcept;
+
+} // namespace linglong::utils
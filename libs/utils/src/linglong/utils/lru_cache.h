@@ -0,0 +1,75 @@
+/*
+ * SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <optional>
+#include <utility>
+
+namespace linglong::utils {
+
+// A small least-recently-used cache, Key must be ordered by operator<.
+// It is not thread safe, callers should guard it if it is shared between threads.
+template<typename Key, typename Value>
+class LRUCache
+{
+public:
+    explicit LRUCache(std::size_t capacity) noexcept
+        : capacity(capacity)
+    {
+    }
+
+    std::optional<Value> get(const Key &key)
+    {
+        auto it = this->index.find(key);
+        if (it == this->index.end()) {
+            return std::nullopt;
+        }
+
+        // move the entry to the front, it is the most recently used one now
+        this->entries.splice(this->entries.begin(), this->entries, it->second);
+        return it->second->second;
+    }
+
+    void put(const Key &key, Value value)
+    {
+        if (this->capacity == 0) {
+            return;
+        }
+
+        auto it = this->index.find(key);
+        if (it != this->index.end()) {
+            it->second->second = std::move(value);
+            this->entries.splice(this->entries.begin(), this->entries, it->second);
+            return;
+        }
+
+        if (this->entries.size() >= this->capacity) {
+            this->index.erase(this->entries.back().first);
+            this->entries.pop_back();
+        }
+
+        this->entries.emplace_front(key, std::move(value));
+        this->index.emplace(key, this->entries.begin());
+    }
+
+    void clear() noexcept
+    {
+        this->index.clear();
+        this->entries.clear();
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return this->entries.size(); }
+
+private:
+    std::size_t capacity;
+    std::list<std::pair<Key, Value>> entries;
+    std::map<Key, typename std::list<std::pair<Key, Value>>::iterator> index;
+};
+
+} // namespace linglong::utils
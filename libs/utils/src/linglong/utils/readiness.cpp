@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "readiness.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace linglong::utils {
+
+namespace {
+
+constexpr std::string_view readyMessage = "READY=1";
+
+// abstract socket address starts with '@' in NOTIFY_SOCKET, and with '\0' in sockaddr_un
+socklen_t toSockAddr(const std::string &addr, sockaddr_un &sockAddr) noexcept
+{
+    sockAddr = {};
+    sockAddr.sun_family = AF_UNIX;
+    std::memcpy(sockAddr.sun_path, addr.data(), addr.size());
+    if (sockAddr.sun_path[0] == '@') {
+        sockAddr.sun_path[0] = '\0';
+    }
+
+    return offsetof(sockaddr_un, sun_path) + addr.size();
+}
+
+} // namespace
+
+ReadinessListener::ReadinessListener(int fd, std::string addr) noexcept
+    : fd(fd)
+    , addr(std::move(addr))
+{
+}
+
+ReadinessListener::ReadinessListener(ReadinessListener &&other) noexcept
+    : fd(other.fd)
+    , addr(std::move(other.addr))
+{
+    other.fd = -1;
+}
+
+ReadinessListener::~ReadinessListener()
+{
+    if (this->fd != -1) {
+        ::close(this->fd);
+    }
+}
+
+error::Result<ReadinessListener> ReadinessListener::create() noexcept
+{
+    LINGLONG_TRACE("create readiness listener");
+
+    auto fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+        return LINGLONG_ERR(QString{ "socket: " } + ::strerror(errno));
+    }
+
+    auto addr = "@linglong/notify/" + std::to_string(::getpid());
+    sockaddr_un sockAddr{};
+    if (addr.size() >= sizeof(sockAddr.sun_path)) {
+        ::close(fd);
+        return LINGLONG_ERR("socket address is too long");
+    }
+
+    auto len = toSockAddr(addr, sockAddr);
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&sockAddr), len) == -1) {
+        auto msg = QString{ "bind: " } + ::strerror(errno);
+        ::close(fd);
+        return LINGLONG_ERR(msg);
+    }
+
+    return ReadinessListener{ fd, std::move(addr) };
+}
+
+error::Result<void> ReadinessListener::wait(std::chrono::milliseconds timeout) noexcept
+{
+    LINGLONG_TRACE("wait for service ready");
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        auto remain = std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline - std::chrono::steady_clock::now());
+        if (remain.count() <= 0) {
+            return LINGLONG_ERR("timeout");
+        }
+
+        pollfd pfd{ .fd = this->fd, .events = POLLIN, .revents = 0 };
+        auto ret = ::poll(&pfd, 1, static_cast<int>(remain.count()));
+        if (ret == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return LINGLONG_ERR(QString{ "poll: " } + ::strerror(errno));
+        }
+
+        if (ret == 0) {
+            return LINGLONG_ERR("timeout");
+        }
+
+        // a notification may contain several newline separated assignments
+        char buf[256];
+        auto len = ::recv(this->fd, buf, sizeof(buf) - 1, 0);
+        if (len == -1) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            return LINGLONG_ERR(QString{ "recv: " } + ::strerror(errno));
+        }
+
+        std::string_view message{ buf, static_cast<std::size_t>(len) };
+        while (!message.empty()) {
+            auto end = message.find('\n');
+            if (message.substr(0, end) == readyMessage) {
+                return LINGLONG_OK;
+            }
+            if (end == std::string_view::npos) {
+                break;
+            }
+            message.remove_prefix(end + 1);
+        }
+    }
+}
+
+error::Result<void> notifyReady() noexcept
+{
+    LINGLONG_TRACE("notify service ready");
+
+    auto *env = ::getenv("NOTIFY_SOCKET");
+    if (env == nullptr || env[0] == '\0') {
+        return LINGLONG_OK;
+    }
+
+    std::string addr{ env };
+    sockaddr_un sockAddr{};
+    if ((addr[0] != '@' && addr[0] != '/') || addr.size() >= sizeof(sockAddr.sun_path)) {
+        return LINGLONG_ERR("invalid NOTIFY_SOCKET: " + QString::fromStdString(addr));
+    }
+
+    auto fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+        return LINGLONG_ERR(QString{ "socket: " } + ::strerror(errno));
+    }
+
+    auto len = toSockAddr(addr, sockAddr);
+    auto ret = ::sendto(fd,
+                        readyMessage.data(),
+                        readyMessage.size(),
+                        MSG_NOSIGNAL,
+                        reinterpret_cast<sockaddr *>(&sockAddr),
+                        len);
+    auto savedErrno = errno;
+    ::close(fd);
+    if (ret == -1) {
+        return LINGLONG_ERR(QString{ "sendto: " } + ::strerror(savedErrno));
+    }
+
+    return LINGLONG_OK;
+}
+
+} // namespace linglong::utils
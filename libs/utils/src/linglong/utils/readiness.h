@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linglong/utils/error/error.h"
+
+#include <chrono>
+#include <string>
+
+namespace linglong::utils {
+
+// A tiny implementation of the readiness part of sd_notify(3) protocol.
+// The waiting side binds a datagram socket in the abstract namespace and passes its address to
+// the service by NOTIFY_SOCKET, the service sends "READY=1" once it is able to serve requests.
+class ReadinessListener
+{
+public:
+    ReadinessListener(const ReadinessListener &) = delete;
+    ReadinessListener &operator=(const ReadinessListener &) = delete;
+    ReadinessListener(ReadinessListener &&other) noexcept;
+    ReadinessListener &operator=(ReadinessListener &&other) = delete;
+    ~ReadinessListener();
+
+    static error::Result<ReadinessListener> create() noexcept;
+
+    // the value which should be set to NOTIFY_SOCKET of the service
+    [[nodiscard]] const std::string &address() const noexcept { return addr; }
+
+    error::Result<void> wait(std::chrono::milliseconds timeout) noexcept;
+
+private:
+    ReadinessListener(int fd, std::string addr) noexcept;
+
+    int fd{ -1 };
+    std::string addr;
+};
+
+// Send "READY=1" to NOTIFY_SOCKET, do nothing if it isn't set.
+error::Result<void> notifyReady() noexcept;
+
+} // namespace linglong::utils
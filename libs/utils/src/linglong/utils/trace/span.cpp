@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "span.h"
+
+#include <nlohmann/json.hpp>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace linglong::utils::trace {
+
+namespace {
+
+struct TraceFile
+{
+    std::string path;
+    int fd{ -1 };
+};
+
+// never destroyed, the spans may end in the destructors of static objects
+TraceFile &traceFileInstance() noexcept
+{
+    static auto *file = new TraceFile; // NOLINT
+    return *file;
+}
+
+bool writeAll(int fd, const std::string &data) noexcept
+{
+    // the file is opened with O_APPEND, a single write won't be interleaved with the others
+    auto ret = ::write(fd, data.c_str(), data.size());
+    return ret == static_cast<ssize_t>(data.size());
+}
+
+// the name of the process shown by the trace viewer
+std::string processNameEvent()
+{
+    return nlohmann::json{ { "name", "process_name" },
+                           { "ph", "M" },
+                           { "pid", ::getpid() },
+                           { "args", { { "name", program_invocation_short_name } } } }
+      .dump();
+}
+
+} // namespace
+
+bool details::initialize() noexcept
+{
+    const auto *env = ::getenv("LINGLONG_TRACE_FILE");
+    if (env == nullptr || env[0] == '\0') {
+        return false;
+    }
+
+    std::error_code ec;
+    auto path = std::filesystem::absolute(env, ec);
+    if (ec) {
+        std::cerr << "invalid LINGLONG_TRACE_FILE " << env << ": " << ec.message() << std::endl;
+        return false;
+    }
+
+    try {
+        // the process which creates the file begins the array, the others always prepend a comma
+        auto event = processNameEvent();
+        auto fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+        if (fd != -1) {
+            event = "[" + event;
+        } else if (errno == EEXIST) {
+            fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+            event = ",\n" + event;
+        }
+
+        if (fd == -1 || !writeAll(fd, event)) {
+            std::cerr << "failed to write trace file " << path << ": " << ::strerror(errno)
+                      << std::endl;
+            if (fd != -1) {
+                ::close(fd);
+            }
+            return false;
+        }
+
+        auto &file = traceFileInstance();
+        file.path = path.string();
+        file.fd = fd;
+    } catch (const std::exception &e) {
+        std::cerr << "failed to initialize tracing: " << e.what() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+const std::string &traceFile() noexcept
+{
+    enabled();
+    return traceFileInstance().path;
+}
+
+int64_t now() noexcept
+{
+    struct timespec ts{};
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+void record(std::string_view name, std::string_view category, int64_t start) noexcept
+{
+    if (!enabled()) {
+        return;
+    }
+
+    try {
+        auto end = now();
+        auto event = nlohmann::json{ { "name", std::string{ name } },
+                                     { "cat", std::string{ category } },
+                                     { "ph", "X" },
+                                     { "ts", start },
+                                     { "dur", end - start },
+                                     { "pid", ::getpid() },
+                                     { "tid", ::syscall(SYS_gettid) } };
+        writeAll(traceFileInstance().fd, ",\n" + event.dump());
+    } catch (const std::exception &e) {
+        std::cerr << "failed to record span " << name << ": " << e.what() << std::endl;
+    }
+}
+
+Span::Span(std::string_view name, std::string_view category) noexcept
+    : category(category)
+{
+    if (!enabled()) {
+        return;
+    }
+
+    this->name = name;
+    this->start = now();
+}
+
+Span::Span(const QString &name, std::string_view category) noexcept
+    : category(category)
+{
+    if (!enabled()) {
+        return;
+    }
+
+    this->name = name.toStdString();
+    this->start = now();
+}
+
+} // namespace linglong::utils::trace
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linglong/utils/error/error.h"
+
+#include <QString>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Spans of the phases which are worth timing, such as the steps of `ll-cli run`, the tasks of
+// the package manager and the stages of ll-builder. If LINGLONG_TRACE_FILE is set, the spans are
+// appended to that file as Chrome trace events, which can be opened by https://ui.perfetto.dev
+// or chrome://tracing. Otherwise a span costs a check of a cached flag.
+//
+// Every event is appended by a single write(2), processes started with the same
+// LINGLONG_TRACE_FILE share the file, and the file is kept valid after a crash because the
+// closing bracket of the JSON array format is optional. Remove the file to start a new trace.
+
+namespace linglong::utils::trace {
+
+namespace details {
+bool initialize() noexcept;
+} // namespace details
+
+inline bool enabled() noexcept
+{
+    static const bool ret = details::initialize();
+    return ret;
+}
+
+// the absolute path of the trace file, empty if tracing is disabled
+const std::string &traceFile() noexcept;
+
+// microseconds of CLOCK_MONOTONIC, all processes on the host use the same clock
+int64_t now() noexcept;
+
+// record a complete event which started at `start` and ends now
+void record(std::string_view name, std::string_view category, int64_t start) noexcept;
+
+class Span
+{
+public:
+    explicit Span(std::string_view name, std::string_view category = "linglong") noexcept;
+    explicit Span(const QString &name, std::string_view category = "linglong") noexcept;
+
+    // a string literal converts to both std::string_view and QString
+    explicit Span(const char *name, std::string_view category = "linglong") noexcept
+        : Span(std::string_view{ name }, category)
+    {
+    }
+
+    Span(const Span &) = delete;
+    Span(Span &&) = delete;
+    Span &operator=(const Span &) = delete;
+    Span &operator=(Span &&) = delete;
+    ~Span() { end(); }
+
+    // end the span before leaving the scope, it is recorded only once
+    void end() noexcept
+    {
+        if (start < 0) {
+            return;
+        }
+
+        record(name, category, start);
+        start = -1;
+    }
+
+private:
+    std::string name;
+    std::string_view category;
+    int64_t start{ -1 };
+};
+
+} // namespace linglong::utils::trace
+
+// Same as LINGLONG_TRACE, and the rest of the scope is recorded as a span named by the message.
+#define LINGLONG_TRACE_SPAN(message) \
+    LINGLONG_TRACE(message)          \
+    const ::linglong::utils::trace::Span linglong_trace_span{ linglong_trace_message };
@@ -100,16 +100,42 @@ collectDependsLibs() {
                 # and it also can be executed. Therefore, try to find the executable binary with the symbol “__libc_start_main”
                 has_start="$(nm -D ${filePath} /dev/null 2>&1 | grep "__libc_start_main" || true)"
                 if [[ -n ${has_start} ]]; then
-                        recordPath=$(mktemp)
-                        processExecBin "${filePath}" "${recordPath}"
-                        if [[ -s ${recordPath} ]]; then
-                                records="$(cat $recordPath)"
-                                rm "$recordPath"
-                                logErr "\n$records"
-                        fi
+                        checkExecBin "${filePath}"
                 fi
         done
 
+        removeDuplicates
+}
+
+# The executable binaries are listed by ll-builder, one path per line
+collectListedDependsLibs() {
+        declare listPath="$1"
+        if [[ -z ${listPath} || ! -f ${listPath} ]]; then
+                logErr "Invalid file list: ${listPath}"
+        fi
+
+        while IFS= read -r filePath; do
+                if [[ -n ${filePath} ]]; then
+                        checkExecBin "${filePath}"
+                fi
+        done <"${listPath}"
+
+        removeDuplicates
+}
+
+checkExecBin() {
+        local filePath="$1"
+        recordPath=$(mktemp)
+        processExecBin "${filePath}" "${recordPath}"
+        if [[ -s ${recordPath} ]]; then
+                records="$(cat $recordPath)"
+                rm "$recordPath"
+                logErr "\n$records"
+        fi
+        rm -f "$recordPath"
+}
+
+removeDuplicates() {
         # remove duplicates
         local oldIFS="${IFS}"
         IFS=" " read -r -a dependLibs <<<"$(echo "${dependLibs[@]}" | tr ' ' '\n' | sort -u | tr '\n' ' ' || true)"
@@ -121,7 +147,8 @@ main() {
         if [[ -z ${arg1} ]]; then
                 echo "usage:
                         ldd-check.sh path
-                        ldd-check.sh [path:...]"
+                        ldd-check.sh [path:...]
+                        ldd-check.sh --file-list file"
                 return 0
         fi
 
@@ -133,7 +160,11 @@ main() {
         fi
 
         # Collect the needed dynamic libraries for the specified binaries
-        collectDependsLibs "${arg1}"
+        if [[ ${arg1} == "--file-list" ]]; then
+                collectListedDependsLibs "$2"
+        else
+                collectDependsLibs "${arg1}"
+        fi
 
         # remove all library which from /runtime
         local oldIFS="${IFS}"
@@ -0,0 +1,96 @@
+#!/bin/env bash
+
+# SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+#
+# SPDX-License-Identifier: LGPL-3.0-or-later
+
+# 对比不同erofs profile打包同一目录时的镜像大小、打包耗时和冷读取耗时
+# 用法: erofs-profile-bench.sh <dir> [profile...]
+# 冷读取前需要清空page cache，非root用户运行时读取耗时为热读取耗时
+# profile参数与 libs/linglong/src/linglong/package/erofs_profile.cpp 保持一致
+
+set -e
+
+declare -A profiles=(
+        [default]="-zlz4 -Efragments,dedupe,ztailpacking -C1048576 -b4096"
+        [fast-build]="-zlz4 -Eztailpacking -b4096"
+        [small]="-zlzma -Efragments,dedupe,ztailpacking -C1048576 -b4096"
+        [fast-read]="-zlz4hc -Eztailpacking -C65536 -b4096"
+)
+
+dir=$1
+shift || true
+if [ ! -d "$dir" ]; then
+        echo "usage: $0 <dir> [profile...]"
+        echo "profiles: ${!profiles[*]}"
+        exit 1
+fi
+
+for cmd in mkfs.erofs erofsfuse fusermount; do
+        if ! command -v "$cmd" >/dev/null 2>&1; then
+                echo "$cmd not found, please install erofs-utils and erofsfuse"
+                exit 1
+        fi
+done
+
+names=("$@")
+if [ ${#names[@]} -eq 0 ]; then
+        names=(default fast-build small fast-read)
+fi
+
+workdir=$(mktemp -d)
+trap 'fusermount -u "$workdir/mnt" 2>/dev/null || true; rm -rf "$workdir"' EXIT
+mkdir "$workdir/mnt"
+
+dropCaches() {
+        if [ "$(id -u)" -eq 0 ]; then
+                sync
+                echo 3 >/proc/sys/vm/drop_caches
+        fi
+}
+
+elapsed() {
+        local begin end
+        begin=$(date +%s%N)
+        "$@" >/dev/null 2>&1
+        end=$(date +%s%N)
+        echo $(((end - begin) / 1000000))
+}
+
+readAll() {
+        tar -C "$1" -cf - . >/dev/null
+}
+
+# 随机读取每个文件的第一个块，模拟按需加载资源
+readRandom() {
+        find "$1" -type f -print0 | shuf -z | xargs -0 -r -n 64 head -c 4096 >/dev/null
+}
+
+if [ "$(id -u)" -ne 0 ]; then
+        echo "Warning: not running as root, page cache isn't dropped before reading"
+fi
+
+printf "%-12s %12s %10s %12s %12s\n" "profile" "size(KiB)" "build(ms)" "read(ms)" "random(ms)"
+for name in "${names[@]}"; do
+        if [ -z "${profiles[$name]}" ]; then
+                echo "unknown profile $name"
+                exit 1
+        fi
+
+        image="$workdir/$name.erofs"
+        # shellcheck disable=SC2086
+        build=$(elapsed mkfs.erofs ${profiles[$name]} "$image" "$dir")
+        size=$(($(stat -c %s "$image") / 1024))
+
+        dropCaches
+        erofsfuse "$image" "$workdir/mnt" >/dev/null
+        read=$(elapsed readAll "$workdir/mnt")
+        fusermount -u "$workdir/mnt"
+
+        dropCaches
+        erofsfuse "$image" "$workdir/mnt" >/dev/null
+        random=$(elapsed readRandom "$workdir/mnt")
+        fusermount -u "$workdir/mnt"
+
+        printf "%-12s %12s %10s %12s %12s\n" "$name" "$size" "$build" "$read" "$random"
+done
@@ -0,0 +1,70 @@
+#!/bin/env bash
+
+# SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+#
+# SPDX-License-Identifier: LGPL-3.0-or-later
+
+# 构建并运行ll-bench，结果以JSON格式保存到 $builddir/bench-results/<commit>.json
+# 用法: run-benchmark.sh [ll-bench参数...]，例如 --benchmark_filter=Version
+#       run-benchmark.sh compare <旧结果.json> <新结果.json>
+# 对比时优先使用google benchmark提供的compare.py，否则使用jq输出耗时变化
+
+set -e
+
+cd "$(git rev-parse --show-toplevel)" || exit 255
+
+builddir=${BUILD_DIR:-build-benchmark}
+
+if [ "$1" = "compare" ]; then
+        if [ $# -ne 3 ]; then
+                echo "usage: $0 compare <old.json> <new.json>"
+                exit 1
+        fi
+
+        if command -v compare.py &>/dev/null; then
+                exec compare.py benchmarks "$2" "$3"
+        fi
+
+        if ! command -v jq &>/dev/null; then
+                echo "neither compare.py nor jq found"
+                exit 1
+        fi
+
+        printf "%-60s %14s %14s %6s %8s\n" name old new unit change
+        jq -r -n --slurpfile old "$2" --slurpfile new "$3" '
+                ($old[0].benchmarks | map({ key: .name, value: .real_time }) | from_entries) as $o
+                | $new[0].benchmarks[]
+                | select(.run_type == "iteration" and $o[.name] != null)
+                | [.name, $o[.name], .real_time, .time_unit,
+                   ((.real_time - $o[.name]) / $o[.name] * 100)]
+                | @tsv' |
+                while IFS=$'\t' read -r name old new unit change; do
+                        printf "%-60s %14.2f %14.2f %6s %+7.1f%%\n" \
+                                "$name" "$old" "$new" "$unit" "$change"
+                done
+        exit 0
+fi
+
+command -v ccache &>/dev/null && {
+        USE_CCACHE=-DCMAKE_CXX_COMPILER_LAUNCHER=ccache
+}
+
+# shellcheck disable=SC2086
+cmake -B "$builddir" -S . $USE_CCACHE \
+        -DCMAKE_BUILD_TYPE=Release \
+        -DENABLE_TESTING=OFF \
+        -DENABLE_BENCHMARK=ON || exit 255
+
+NUM_JOBS=${NUM_JOBS:-$(nproc)}
+cmake --build "$builddir" -j "$NUM_JOBS" -t linglong__linglong__ll-bench || exit 255
+
+outdir="$builddir/bench-results"
+mkdir -p "$outdir"
+out="$outdir/$(git describe --always --dirty).json"
+
+"$builddir/libs/linglong/tests/ll-bench/ll-bench" \
+        --benchmark_out="$out" \
+        --benchmark_out_format=json \
+        "$@"
+
+echo "results are saved to $out"